@@ -0,0 +1,360 @@
+/**
+ * Async Pipeline Executor Implementation
+ */
+
+#include "async_pipeline.h"
+#include <stddef.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+
+#define ASYNC_LINK_MASK (ASYNC_LINK_DEPTH - 1)
+#define ASYNC_MAX_EVENTS 64
+
+// Worker running on this thread, NULL on non-worker threads
+static _Thread_local AsyncWorker *tls_worker = NULL;
+
+static void runq_push(AsyncRunQueue *q, AsyncPipeline *p) {
+    p->next = NULL;
+    if (q->tail != NULL) {
+        q->tail->next = p;
+    } else {
+        q->head = p;
+    }
+    q->tail = p;
+}
+
+static void schedule(AsyncPipeline *p) {
+    // One queue entry per pipeline no matter how many wakeups race
+    if (atomic_exchange(&p->queued, true)) {
+        return;
+    }
+
+    AsyncWorker *w = p->worker;
+    if (tls_worker == w) {
+        runq_push(&w->runq, p);
+        return;
+    }
+
+    pthread_mutex_lock(&w->lock);
+    runq_push(&w->inbox, p);
+    pthread_mutex_unlock(&w->lock);
+
+    uint64_t one = 1;
+    ssize_t r = write(w->wakefd, &one, sizeof(one));
+    (void)r;  // EAGAIN only if the counter is saturated, already awake then
+}
+
+// Each parked stage owns its registration; the event carries the stage.
+// Returns 0 once the fd is armed, otherwise the epoll_ctl errno.
+static int arm_fd(AsyncWorker *w, AsyncStage *s) {
+    struct epoll_event ev;
+    ev.events = EPOLLIN | EPOLLONESHOT;
+    ev.data.ptr = s;
+
+    if (s->armed_fd == s->wait_fd) {
+        if (epoll_ctl(w->epfd, EPOLL_CTL_MOD, s->wait_fd, &ev) == 0) {
+            return 0;
+        }
+        if (errno != ENOENT) {
+            return errno;
+        }
+        s->armed_fd = -1;  // Closed (and maybe reopened) since the last wait
+    }
+    if (s->armed_fd >= 0) {
+        // Fails only if the old fd was already closed, which removed it too
+        epoll_ctl(w->epfd, EPOLL_CTL_DEL, s->armed_fd, NULL);
+        s->armed_fd = -1;
+    }
+    if (epoll_ctl(w->epfd, EPOLL_CTL_ADD, s->wait_fd, &ev) != 0) {
+        return errno;
+    }
+    s->armed_fd = s->wait_fd;
+    return 0;
+}
+
+static void finish(AsyncWorker *w, AsyncPipeline *p) {
+    AsyncExecutor *ex = w->exec;
+
+    for (uint8_t i = 0; i < p->num_stages; i++) {
+        AsyncStage *s = &p->stages[i];
+        if (s->armed_fd >= 0) {
+            epoll_ctl(w->epfd, EPOLL_CTL_DEL, s->armed_fd, NULL);
+            s->armed_fd = -1;
+        }
+    }
+    atomic_store(&p->finished, true);
+
+    if (atomic_fetch_sub(&ex->active, 1) == 1) {
+        pthread_mutex_lock(&ex->idle_lock);
+        pthread_cond_broadcast(&ex->idle_cond);
+        pthread_mutex_unlock(&ex->idle_lock);
+    }
+}
+
+static void run_pipeline(AsyncWorker *w, AsyncPipeline *p) {
+    AsyncStage *sink = &p->stages[p->num_stages - 1];
+
+    for (int round = 0; round < ASYNC_RUN_BUDGET; round++) {
+        bool progress = false;
+
+        for (uint8_t i = 0; i < p->num_stages; i++) {
+            AsyncStage *s = &p->stages[i];
+            if (s->done || s->parked) {
+                continue;
+            }
+
+            CoStatus st = s->fn(s);
+            if (st == CO_DONE) {
+                s->done = true;
+                progress = true;
+            } else if (st == CO_YIELDED) {
+                progress = true;
+            } else if (s->parked) {
+                int err = arm_fd(w, s);
+                if (err != 0) {
+                    // Regular files cannot be polled (EPERM) but never block:
+                    // treat them as ready. Other errors go back to the stage.
+                    s->parked = false;
+                    s->wait_fd = -1;
+                    s->wait_err = (err == EPERM) ? 0 : err;
+                    progress = true;
+                }
+            }
+        }
+
+        if (sink->done) {
+            finish(w, p);
+            return;
+        }
+        if (!progress) {
+            return;  // Resumed by an fd event or async_pipeline_wake()
+        }
+    }
+
+    // Still busy after its budget: go to the back of the queue
+    schedule(p);
+}
+
+static void *worker_main(void *arg) {
+    AsyncWorker *w = (AsyncWorker *)arg;
+    struct epoll_event events[ASYNC_MAX_EVENTS];
+
+    tls_worker = w;
+
+    while (!atomic_load(&w->exec->stop)) {
+        int timeout = (w->runq.head != NULL) ? 0 : -1;
+        int n = epoll_wait(w->epfd, events, ASYNC_MAX_EVENTS, timeout);
+
+        for (int i = 0; i < n; i++) {
+            AsyncStage *s = (AsyncStage *)events[i].data.ptr;
+
+            if (s == NULL) {
+                uint64_t count;
+                ssize_t r = read(w->wakefd, &count, sizeof(count));
+                (void)r;
+                continue;
+            }
+
+            // Only the stage whose fd fired resumes; others stay parked
+            s->parked = false;
+            s->wait_fd = -1;
+            schedule(s->pipeline);
+        }
+
+        pthread_mutex_lock(&w->lock);
+        if (w->inbox.head != NULL) {
+            if (w->runq.tail != NULL) {
+                w->runq.tail->next = w->inbox.head;
+            } else {
+                w->runq.head = w->inbox.head;
+            }
+            w->runq.tail = w->inbox.tail;
+            w->inbox.head = w->inbox.tail = NULL;
+        }
+        pthread_mutex_unlock(&w->lock);
+
+        // Run a snapshot; anything rescheduled now waits for the next pass
+        AsyncPipeline *p = w->runq.head;
+        w->runq.head = w->runq.tail = NULL;
+
+        while (p != NULL) {
+            AsyncPipeline *next = p->next;
+            atomic_store(&p->queued, false);
+            run_pipeline(w, p);
+            w->turns++;
+            p = next;
+        }
+    }
+
+    return NULL;
+}
+
+bool async_exec_init(AsyncExecutor *ex, uint8_t num_workers) {
+    if (num_workers == 0 || num_workers > ASYNC_MAX_WORKERS) {
+        return false;
+    }
+
+    ex->num_workers = num_workers;
+    ex->next_worker = 0;
+    atomic_init(&ex->stop, false);
+    atomic_init(&ex->active, 0);
+    pthread_mutex_init(&ex->idle_lock, NULL);
+    pthread_cond_init(&ex->idle_cond, NULL);
+
+    for (uint8_t i = 0; i < num_workers; i++) {
+        AsyncWorker *w = &ex->workers[i];
+        w->exec = ex;
+        w->runq.head = w->runq.tail = NULL;
+        w->inbox.head = w->inbox.tail = NULL;
+        w->turns = 0;
+        pthread_mutex_init(&w->lock, NULL);
+
+        w->epfd = epoll_create1(EPOLL_CLOEXEC);
+        w->wakefd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+        struct epoll_event ev;
+        ev.events = EPOLLIN;
+        ev.data.ptr = NULL;
+
+        if (w->epfd < 0 || w->wakefd < 0 ||
+            epoll_ctl(w->epfd, EPOLL_CTL_ADD, w->wakefd, &ev) != 0 ||
+            pthread_create(&w->thread, NULL, worker_main, w) != 0) {
+            // Worker i never started: release its own resources, then
+            // stop the ones that did
+            if (w->epfd >= 0) {
+                close(w->epfd);
+            }
+            if (w->wakefd >= 0) {
+                close(w->wakefd);
+            }
+            pthread_mutex_destroy(&w->lock);
+            ex->num_workers = i;
+            async_exec_shutdown(ex);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void async_exec_submit(AsyncExecutor *ex, AsyncPipeline *p) {
+    p->worker = &ex->workers[ex->next_worker];
+    ex->next_worker = (uint8_t)((ex->next_worker + 1) % ex->num_workers);
+
+    atomic_fetch_add(&ex->active, 1);
+    schedule(p);
+}
+
+void async_exec_wait(AsyncExecutor *ex) {
+    pthread_mutex_lock(&ex->idle_lock);
+    while (atomic_load(&ex->active) != 0) {
+        pthread_cond_wait(&ex->idle_cond, &ex->idle_lock);
+    }
+    pthread_mutex_unlock(&ex->idle_lock);
+}
+
+void async_exec_shutdown(AsyncExecutor *ex) {
+    atomic_store(&ex->stop, true);
+
+    for (uint8_t i = 0; i < ex->num_workers; i++) {
+        uint64_t one = 1;
+        ssize_t r = write(ex->workers[i].wakefd, &one, sizeof(one));
+        (void)r;
+    }
+
+    for (uint8_t i = 0; i < ex->num_workers; i++) {
+        AsyncWorker *w = &ex->workers[i];
+        pthread_join(w->thread, NULL);
+        close(w->epfd);
+        close(w->wakefd);
+        pthread_mutex_destroy(&w->lock);
+    }
+
+    pthread_mutex_destroy(&ex->idle_lock);
+    pthread_cond_destroy(&ex->idle_cond);
+}
+
+void async_pipeline_init(AsyncPipeline *p, uint32_t id) {
+    p->num_stages = 0;
+    p->id = id;
+    p->worker = NULL;
+    atomic_init(&p->queued, false);
+    atomic_init(&p->finished, false);
+    p->next = NULL;
+}
+
+bool async_pipeline_add_stage(AsyncPipeline *p, AsyncStageFn fn, void *user) {
+    if (p->num_stages >= ASYNC_MAX_STAGES) {
+        return false;
+    }
+
+    uint8_t i = p->num_stages;
+    AsyncStage *s = &p->stages[i];
+    s->fn = fn;
+    s->user = user;
+    s->co_line = 0;
+    s->done = false;
+    s->parked = false;
+    s->wait_fd = -1;
+    s->armed_fd = -1;
+    s->wait_err = 0;
+    s->in = NULL;
+    s->out = NULL;
+    s->pipeline = p;
+
+    if (i > 0) {
+        AsyncLink *link = &p->links[i - 1];
+        link->head = 0;
+        link->tail = 0;
+        p->stages[i - 1].out = link;
+        s->in = link;
+    }
+
+    p->num_stages++;
+    return true;
+}
+
+void async_pipeline_wake(AsyncPipeline *p) {
+    if (!atomic_load(&p->finished)) {
+        schedule(p);
+    }
+}
+
+void async_park(AsyncStage *s, int fd) {
+    s->parked = true;
+    s->wait_fd = fd;
+    s->wait_err = 0;
+}
+
+bool async_in_ready(const AsyncStage *s) {
+    return s->in != NULL && s->in->head != s->in->tail;
+}
+
+bool async_in_closed(const AsyncStage *s) {
+    if (s->in == NULL || s->in->head != s->in->tail) {
+        return false;
+    }
+    return (s - 1)->done;  // Input link always comes from the previous stage
+}
+
+const AsyncBlock *async_in_block(const AsyncStage *s) {
+    return &s->in->blocks[s->in->tail & ASYNC_LINK_MASK];
+}
+
+void async_in_release(AsyncStage *s) {
+    s->in->tail++;
+}
+
+bool async_out_ready(const AsyncStage *s) {
+    return s->out != NULL && s->out->head - s->out->tail < ASYNC_LINK_DEPTH;
+}
+
+AsyncBlock *async_out_block(AsyncStage *s) {
+    return &s->out->blocks[s->out->head & ASYNC_LINK_MASK];
+}
+
+void async_out_commit(AsyncStage *s) {
+    s->out->head++;
+}
@@ -0,0 +1,251 @@
+/**
+ * Async Pipeline Executor
+ * Stackless coroutine stages multiplexed on a small epoll thread pool
+ *
+ * Each channel pipeline is a chain of stages. A stage is a resumable
+ * function (protothread style: the resume point is a line number stored
+ * in the stage, so there is no per-coroutine stack) that awaits input
+ * blocks, awaits output space, or awaits a readable file descriptor, and
+ * yields whenever it moved a block. One worker thread can therefore
+ * interleave thousands of pipelines without a thread per channel and
+ * without ever blocking in read().
+ *
+ * Key points:
+ * - Pipelines are pinned to one worker, so stages and links need no locks
+ * - Each worker owns an epoll set; fds are armed one-shot per wait
+ * - Cross-thread wakeups (shared memory producers) go through a locked
+ *   inbox plus an eventfd, the only lock on the path
+ * - All storage is caller-provided (no malloc)
+ *
+ * Coroutine rules (as for any switch-based coroutine):
+ * - Locals do not survive a CO_* point; keep state in s->user
+ * - At most one CO_* macro per source line, no CO_* inside a nested switch
+ *
+ * Linux only (epoll, eventfd). Link with -pthread.
+ */
+
+#ifndef ASYNC_PIPELINE_H
+#define ASYNC_PIPELINE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <pthread.h>
+
+#define ASYNC_BLOCK_LEN 64          // Samples per block
+#define ASYNC_LINK_DEPTH 4          // Blocks buffered between stages (power of 2)
+#define ASYNC_MAX_STAGES 6
+#define ASYNC_MAX_WORKERS 16
+#define ASYNC_RUN_BUDGET 16         // Stage rounds per turn before yielding the worker
+
+typedef enum {
+    CO_WAITING = 0,                 // Blocked, no progress
+    CO_YIELDED,                     // Made progress, call again
+    CO_DONE                         // Finished, end of stream
+} CoStatus;
+
+typedef struct {
+    float data[ASYNC_BLOCK_LEN];
+    uint16_t len;
+    uint32_t seq;
+} AsyncBlock;
+
+typedef struct {
+    AsyncBlock blocks[ASYNC_LINK_DEPTH];
+    uint32_t head;                  // Blocks committed by the upstream stage
+    uint32_t tail;                  // Blocks released by the downstream stage
+} AsyncLink;
+
+typedef struct AsyncStage AsyncStage;
+typedef struct AsyncPipeline AsyncPipeline;
+typedef struct AsyncWorker AsyncWorker;
+typedef struct AsyncExecutor AsyncExecutor;
+
+typedef CoStatus (*AsyncStageFn)(AsyncStage *s);
+
+struct AsyncStage {
+    AsyncStageFn fn;
+    void *user;                     // Stage state (survives suspension)
+    int co_line;                    // Resume point, 0 = start
+    bool done;
+    bool parked;                    // Waiting on an fd, skipped until it fires
+    int wait_fd;                    // fd requested by async_park, -1 if none
+    int armed_fd;                   // fd this stage has in the worker's epoll set
+    int wait_err;                   // errno if the last fd wait could not be armed
+    AsyncLink *in;                  // NULL for the source stage
+    AsyncLink *out;                 // NULL for the sink stage
+    AsyncPipeline *pipeline;
+};
+
+struct AsyncPipeline {
+    AsyncStage stages[ASYNC_MAX_STAGES];
+    AsyncLink links[ASYNC_MAX_STAGES - 1];
+    uint8_t num_stages;
+    uint32_t id;
+
+    AsyncWorker *worker;
+    atomic_bool queued;             // In a run queue or inbox
+    atomic_bool finished;           // Read by async_pipeline_wake on any thread
+    AsyncPipeline *next;            // Run queue link
+};
+
+typedef struct {
+    AsyncPipeline *head;
+    AsyncPipeline *tail;
+} AsyncRunQueue;
+
+struct AsyncWorker {
+    AsyncExecutor *exec;
+    pthread_t thread;
+    int epfd;
+    int wakefd;                     // eventfd for cross-thread wakeups
+    AsyncRunQueue runq;             // Owner thread only
+    AsyncRunQueue inbox;            // Guarded by lock
+    pthread_mutex_t lock;
+    uint64_t turns;                 // Pipeline turns executed
+};
+
+struct AsyncExecutor {
+    AsyncWorker workers[ASYNC_MAX_WORKERS];
+    uint8_t num_workers;
+    uint8_t next_worker;
+    atomic_bool stop;
+    atomic_uint active;             // Submitted pipelines not yet finished
+    pthread_mutex_t idle_lock;
+    pthread_cond_t idle_cond;
+};
+
+// Falling into a resume label is intended; keeps -Wextra quiet
+#if defined(__GNUC__) && __GNUC__ >= 7
+#define CO_FALLTHROUGH      __attribute__((fallthrough))
+#else
+#define CO_FALLTHROUGH      ((void)0)
+#endif
+
+// Coroutine body delimiters
+#define CO_BEGIN(s)         switch ((s)->co_line) { case 0:
+#define CO_END(s)           } (s)->co_line = -1; return CO_DONE
+
+// Suspend with progress; resume on the next line
+#define CO_YIELD(s)         do { (s)->co_line = __LINE__; return CO_YIELDED; \
+                                 case __LINE__:; } while (0)
+
+// Suspend until cond holds (re-evaluated on every resume)
+#define CO_AWAIT(s, cond)   do { (s)->co_line = __LINE__; CO_FALLTHROUGH; case __LINE__: \
+                                 if (!(cond)) return CO_WAITING; } while (0)
+
+// Suspend until fd is readable; regular files resume at once, and if the
+// fd cannot be watched the stage resumes with s->wait_err set
+#define CO_AWAIT_READABLE(s, fd) do { async_park((s), (fd)); (s)->co_line = __LINE__; \
+                                      return CO_WAITING; case __LINE__:; } while (0)
+
+// Finish the stream from inside the body
+#define CO_EXIT(s)          do { (s)->co_line = -1; return CO_DONE; } while (0)
+
+/**
+ * Start the worker threads
+ * @param ex Pointer to AsyncExecutor
+ * @param num_workers Threads to start (1..ASYNC_MAX_WORKERS)
+ * @return true on success
+ */
+bool async_exec_init(AsyncExecutor *ex, uint8_t num_workers);
+
+/**
+ * Hand a pipeline to the executor (round-robin worker assignment)
+ * @param ex Pointer to AsyncExecutor
+ * @param p Pipeline built with async_pipeline_init / add_stage
+ */
+void async_exec_submit(AsyncExecutor *ex, AsyncPipeline *p);
+
+/**
+ * Block until every submitted pipeline has finished
+ * @param ex Pointer to AsyncExecutor
+ */
+void async_exec_wait(AsyncExecutor *ex);
+
+/**
+ * Stop and join the workers, close their fds
+ * @param ex Pointer to AsyncExecutor
+ */
+void async_exec_shutdown(AsyncExecutor *ex);
+
+/**
+ * Reset a pipeline to zero stages
+ * @param p Pointer to AsyncPipeline
+ * @param id Caller's identifier (e.g. channel number)
+ */
+void async_pipeline_init(AsyncPipeline *p, uint32_t id);
+
+/**
+ * Append a stage; the first stage is the source, the last the sink
+ * @param p Pointer to AsyncPipeline
+ * @param fn Stage coroutine
+ * @param user Stage state
+ * @return true if there was room
+ */
+bool async_pipeline_add_stage(AsyncPipeline *p, AsyncStageFn fn, void *user);
+
+/**
+ * Make a pipeline runnable again (any thread; e.g. after filling shared memory)
+ * @param p Pointer to AsyncPipeline
+ */
+void async_pipeline_wake(AsyncPipeline *p);
+
+/**
+ * Park the calling stage on an fd (used by CO_AWAIT_READABLE); only this
+ * stage resumes when it fires. An fd may be watched by one stage at a time.
+ * Regular files count as always readable; any other fd epoll rejects
+ * resumes the stage at once with its errno in s->wait_err.
+ * @param s Calling stage
+ * @param fd Descriptor to watch for EPOLLIN
+ */
+void async_park(AsyncStage *s, int fd);
+
+/**
+ * Check for an input block
+ * @param s Calling stage
+ * @return true if async_in_block() is valid
+ */
+bool async_in_ready(const AsyncStage *s);
+
+/**
+ * Check for end of stream on the input
+ * @param s Calling stage
+ * @return true if upstream finished and every block was consumed
+ */
+bool async_in_closed(const AsyncStage *s);
+
+/**
+ * Get the oldest input block (valid until async_in_release)
+ * @param s Calling stage
+ * @return Block pointer
+ */
+const AsyncBlock *async_in_block(const AsyncStage *s);
+
+/**
+ * Release the oldest input block
+ * @param s Calling stage
+ */
+void async_in_release(AsyncStage *s);
+
+/**
+ * Check for a free output slot
+ * @param s Calling stage
+ * @return true if async_out_block() is valid
+ */
+bool async_out_ready(const AsyncStage *s);
+
+/**
+ * Get the next free output slot (fill in place, then commit)
+ * @param s Calling stage
+ * @return Block pointer
+ */
+AsyncBlock *async_out_block(AsyncStage *s);
+
+/**
+ * Publish the filled output slot downstream
+ * @param s Calling stage
+ */
+void async_out_commit(AsyncStage *s);
+
+#endif // ASYNC_PIPELINE_H
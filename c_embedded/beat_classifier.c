@@ -0,0 +1,173 @@
+/**
+ * Beat Template Classifier Implementation
+ */
+
+#include "beat_classifier.h"
+#include "dsp_dispatch.h"
+#include <math.h>
+
+#define BC_SPAN (BC_MAX_SEG + 2 * BC_MAX_SHIFT)
+
+bool bc_init(BeatClassifier *bc, const BeatClassifierConfig *cfg) {
+    if (cfg->seg_len < 8 || cfg->seg_len > BC_MAX_SEG || cfg->max_shift > BC_MAX_SHIFT ||
+        cfg->match_ncc <= 0.0f || cfg->match_ncc > 1.0f) {
+        return false;
+    }
+
+    bc->cfg = *cfg;
+    bc->num_templates = 0;
+    bc->beats = 0;
+    return true;
+}
+
+uint16_t bc_post_samples(const BeatClassifier *bc) {
+    return bc->cfg.seg_len / 2 + bc->cfg.max_shift;
+}
+
+// Normalize x[0..n) to zero mean / unit norm into out; returns false if flat
+static bool bc_normalize(const float *x, float *out, uint16_t n) {
+    float mean = dsp_kernels.sum_f32(x, n) / n;
+
+    for (uint16_t i = 0; i < n; i++) {
+        out[i] = x[i] - mean;
+    }
+    float norm = sqrtf(dsp_kernels.dot_f32(out, out, n));
+    if (norm < 1e-9f) {
+        return false;
+    }
+    for (uint16_t i = 0; i < n; i++) {
+        out[i] /= norm;
+    }
+    return true;
+}
+
+static uint8_t bc_dominant(const BeatClassifier *bc) {
+    uint8_t best = 0;
+
+    for (uint8_t t = 1; t < bc->num_templates; t++) {
+        if (bc->templates[t].matches > bc->templates[best].matches) {
+            best = t;
+        }
+    }
+    return best;
+}
+
+BeatLabel bc_classify(BeatClassifier *bc, CircularBuffer *cb, uint16_t beat_age,
+                      BeatResult *out) {
+    uint16_t len = bc->cfg.seg_len;
+    uint16_t shift = bc->cfg.max_shift;
+    uint16_t span = len + 2 * shift;
+    float seg[BC_SPAN];
+    double prefix[BC_SPAN + 1];
+    double prefix_sq[BC_SPAN + 1];
+
+    out->label = BEAT_UNKNOWN;
+    out->template_id = -1;
+    out->ncc = 0.0f;
+    out->shift = 0;
+
+    // Segment centered on the beat, widened by the shift range
+    uint16_t count = cb_count(cb);
+    uint32_t back = (uint32_t)beat_age + len / 2 + shift + 1;  // Samples from newest to segment start
+    if (beat_age < bc_post_samples(bc) || back > count ||
+        !cb_copy(cb, (uint16_t)(count - back), seg, span)) {
+        return BEAT_UNKNOWN;
+    }
+
+    // Remove the DC offset first (raw ADC counts can sit near 1e7), and keep
+    // the prefix sums in double: the windowed energy is a difference of
+    // two large sums and float would cancel most of it
+    float dc = dsp_kernels.sum_f32(seg, span) / span;
+    prefix[0] = 0.0;
+    prefix_sq[0] = 0.0;
+    for (uint16_t i = 0; i < span; i++) {
+        seg[i] -= dc;
+        prefix[i + 1] = prefix[i] + seg[i];
+        prefix_sq[i + 1] = prefix_sq[i] + (double)seg[i] * seg[i];
+    }
+
+    // Best NCC over templates x shifts. Templates are zero-mean, so
+    // dot(window - mean, t) == dot(window, t): one SIMD dot per candidate.
+    int8_t best_t = -1;
+    uint16_t best_s = shift;
+    float best_ncc = -1.0f;
+
+    for (uint8_t t = 0; t < bc->num_templates; t++) {
+        for (uint16_t s = 0; s <= 2 * shift; s++) {
+            double sum = prefix[s + len] - prefix[s];
+            double energy = (prefix_sq[s + len] - prefix_sq[s]) - sum * sum / len;
+            if (energy <= 1e-12) {
+                continue;
+            }
+            float ncc = dsp_kernels.dot_f32(seg + s, bc->templates[t].data, len) /
+                        (float)sqrt(energy);
+            if (ncc > best_ncc) {
+                best_ncc = ncc;
+                best_t = (int8_t)t;
+                best_s = s;
+            }
+        }
+    }
+
+    float beat[BC_MAX_SEG];
+    if (!bc_normalize(seg + best_s, beat, len)) {
+        out->label = BEAT_NOISE;  // Flat line
+        return out->label;
+    }
+
+    bc->beats++;
+    out->ncc = best_ncc;
+    out->shift = (int8_t)((int)best_s - shift);
+
+    if (best_t >= 0 && best_ncc >= bc->cfg.match_ncc) {
+        // Match: adapt the template toward this beat
+        BeatTemplate *tp = &bc->templates[best_t];
+        float rate = bc->cfg.adapt_rate;
+
+        for (uint16_t i = 0; i < len; i++) {
+            tp->data[i] += rate * (beat[i] - tp->data[i]);
+        }
+        float norm = sqrtf(dsp_kernels.dot_f32(tp->data, tp->data, len));
+        for (uint16_t i = 0; i < len; i++) {
+            tp->data[i] /= norm;
+        }
+        tp->matches++;
+
+        out->template_id = best_t;
+        out->label = (best_t == bc_dominant(bc)) ? BEAT_NORMAL : BEAT_ECTOPIC;
+        return out->label;
+    }
+
+    // No match: noise if high-frequency energy dominates
+    float hf = 0.0f;
+    for (uint16_t i = 1; i < len; i++) {
+        float d = beat[i] - beat[i - 1];
+        hf += d * d;
+    }
+    if (hf > bc->cfg.noise_hf_ratio) {  // beat[] has unit energy
+        out->label = BEAT_NOISE;
+        return out->label;
+    }
+
+    // New morphology: add (or replace the least used template)
+    uint8_t slot = bc->num_templates;
+    if (slot == BC_MAX_TEMPLATES) {
+        slot = 0;
+        for (uint8_t t = 1; t < BC_MAX_TEMPLATES; t++) {
+            if (bc->templates[t].matches < bc->templates[slot].matches) {
+                slot = t;
+            }
+        }
+    } else {
+        bc->num_templates++;
+    }
+
+    for (uint16_t i = 0; i < len; i++) {
+        bc->templates[slot].data[i] = beat[i];
+    }
+    bc->templates[slot].matches = 1;
+
+    out->template_id = (int8_t)slot;
+    out->label = (slot == bc_dominant(bc)) ? BEAT_NORMAL : BEAT_ECTOPIC;
+    return out->label;
+}
@@ -0,0 +1,88 @@
+/**
+ * Beat Template Classifier
+ * Normalized cross-correlation against an adaptive template library
+ *
+ * For every beat from the peak detector a segment centered on the beat is
+ * copied out of the CircularBuffer history and compared with each
+ * template at a few alignment shifts. Dot products run on the SIMD
+ * dot_f32 kernel from dsp_dispatch; window means/energies for every shift
+ * come from prefix sums, so each NCC costs one dot product.
+ *
+ * Labels:
+ * - NORMAL  : matches the dominant (most frequently matched) morphology
+ * - ECTOPIC : matches, or founds, a different stable morphology
+ * - NOISE   : matches nothing and is dominated by high-frequency energy
+ */
+
+#ifndef BEAT_CLASSIFIER_H
+#define BEAT_CLASSIFIER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "circular_buffer.h"
+
+#define BC_MAX_SEG       128    // Template length
+#define BC_MAX_SHIFT     4      // Alignment search +/- samples
+#define BC_MAX_TEMPLATES 8
+
+typedef enum {
+    BEAT_NORMAL = 0,
+    BEAT_ECTOPIC,
+    BEAT_NOISE,
+    BEAT_UNKNOWN            // Not enough history to classify
+} BeatLabel;
+
+typedef struct {
+    uint16_t seg_len;       // Samples per beat segment (<= BC_MAX_SEG)
+    uint8_t max_shift;      // Alignment search (<= BC_MAX_SHIFT)
+    float match_ncc;        // NCC needed to match a template (e.g. 0.9)
+    float noise_hf_ratio;   // diff-energy / energy above which an unmatched beat is noise
+    float adapt_rate;       // Template EMA rate on match
+} BeatClassifierConfig;
+
+typedef struct {
+    BeatLabel label;
+    int8_t template_id;     // -1 if none
+    float ncc;              // Best correlation found
+    int8_t shift;           // Best alignment in samples
+} BeatResult;
+
+typedef struct {
+    float data[BC_MAX_SEG];     // Zero-mean, unit-norm
+    uint32_t matches;
+} BeatTemplate;
+
+typedef struct {
+    BeatClassifierConfig cfg;
+    BeatTemplate templates[BC_MAX_TEMPLATES];
+    uint8_t num_templates;
+    uint32_t beats;
+} BeatClassifier;
+
+/**
+ * Initialize the classifier with an empty template library
+ * @param bc Pointer to BeatClassifier
+ * @param cfg Configuration (copied)
+ * @return true if configuration is valid
+ */
+bool bc_init(BeatClassifier *bc, const BeatClassifierConfig *cfg);
+
+/**
+ * Number of samples that must follow a beat before it can be classified
+ * @param bc Pointer to BeatClassifier
+ * @return seg_len / 2 + max_shift
+ */
+uint16_t bc_post_samples(const BeatClassifier *bc);
+
+/**
+ * Classify one beat from the buffer history
+ * @param bc Pointer to BeatClassifier
+ * @param cb Sample history (not modified)
+ * @param beat_age Samples since the beat (0 = newest sample), >= bc_post_samples()
+ * @param out Classification result
+ * @return Assigned label (also in out->label)
+ */
+BeatLabel bc_classify(BeatClassifier *bc, CircularBuffer *cb, uint16_t beat_age,
+                      BeatResult *out);
+
+#endif // BEAT_CLASSIFIER_H
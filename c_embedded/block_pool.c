@@ -0,0 +1,104 @@
+/**
+ * Block Pool Implementation
+ */
+
+#include "block_pool.h"
+#include <stddef.h>
+
+#define HEAD_INDEX(h) ((uint32_t)(h))
+#define HEAD_TAG(h) ((uint32_t)((h) >> 32))
+#define MAKE_HEAD(tag, index) (((uint64_t)(tag) << 32) | (uint64_t)(index))
+
+static void push_free(BlockPool *pool, uint32_t index) {
+    PoolBlock *block = &pool->blocks[index];
+    uint64_t head = atomic_load_explicit(&pool->free_head, memory_order_relaxed);
+
+    // Count before publishing: the release CAS below orders this add before
+    // the matching bp_alloc's subtract, so free_count never wraps below 0
+    atomic_fetch_add_explicit(&pool->free_count, 1, memory_order_relaxed);
+
+    do {
+        atomic_store_explicit(&block->next_free, HEAD_INDEX(head), memory_order_relaxed);
+    } while (!atomic_compare_exchange_weak_explicit(&pool->free_head, &head,
+                                                    MAKE_HEAD(HEAD_TAG(head) + 1, index),
+                                                    memory_order_release,
+                                                    memory_order_relaxed));
+}
+
+void bp_init(BlockPool *pool) {
+    for (uint32_t i = 0; i < BP_NUM_BLOCKS; i++) {
+        PoolBlock *b = &pool->blocks[i];
+        b->len = 0;
+        b->channel = 0;
+        b->seq = 0;
+        b->timestamp_ns = 0;
+        atomic_init(&b->refcount, 0);
+        atomic_init(&b->next_free, (i + 1 < BP_NUM_BLOCKS) ? i + 1 : BP_NIL);
+    }
+
+    atomic_init(&pool->free_head, MAKE_HEAD(0, 0));
+    atomic_init(&pool->free_count, BP_NUM_BLOCKS);
+    atomic_init(&pool->min_free, BP_NUM_BLOCKS);
+    atomic_init(&pool->alloc_failures, 0);
+}
+
+PoolBlock *bp_alloc(BlockPool *pool) {
+    uint64_t head = atomic_load_explicit(&pool->free_head, memory_order_acquire);
+    uint32_t index;
+
+    for (;;) {
+        index = HEAD_INDEX(head);
+        if (index == BP_NIL) {
+            atomic_fetch_add_explicit(&pool->alloc_failures, 1, memory_order_relaxed);
+            return NULL;
+        }
+
+        // next may be stale if another thread popped this block; the tag
+        // then differs and the CAS fails
+        uint32_t next = atomic_load_explicit(&pool->blocks[index].next_free,
+                                             memory_order_relaxed);
+        if (atomic_compare_exchange_weak_explicit(&pool->free_head, &head,
+                                                  MAKE_HEAD(HEAD_TAG(head) + 1, next),
+                                                  memory_order_acquire,
+                                                  memory_order_acquire)) {
+            break;
+        }
+    }
+
+    uint32_t free_now = atomic_fetch_sub_explicit(&pool->free_count, 1,
+                                                  memory_order_relaxed) - 1;
+    uint32_t low = atomic_load_explicit(&pool->min_free, memory_order_relaxed);
+    while (free_now < low &&
+           !atomic_compare_exchange_weak_explicit(&pool->min_free, &low, free_now,
+                                                  memory_order_relaxed,
+                                                  memory_order_relaxed)) {
+    }
+
+    PoolBlock *block = &pool->blocks[index];
+    atomic_store_explicit(&block->refcount, 1, memory_order_relaxed);
+    block->len = 0;
+    return block;
+}
+
+void bp_retain(PoolBlock *block) {
+    // Caller already holds a reference, so the block cannot be freed here
+    atomic_fetch_add_explicit(&block->refcount, 1, memory_order_relaxed);
+}
+
+void bp_release(BlockPool *pool, PoolBlock *block) {
+    if (atomic_fetch_sub_explicit(&block->refcount, 1, memory_order_acq_rel) == 1) {
+        push_free(pool, bp_index(pool, block));
+    }
+}
+
+uint32_t bp_index(const BlockPool *pool, const PoolBlock *block) {
+    return (uint32_t)(block - pool->blocks);
+}
+
+PoolBlock *bp_block(BlockPool *pool, uint32_t index) {
+    return (index < BP_NUM_BLOCKS) ? &pool->blocks[index] : NULL;
+}
+
+uint32_t bp_available(const BlockPool *pool) {
+    return atomic_load_explicit(&pool->free_count, memory_order_relaxed);
+}
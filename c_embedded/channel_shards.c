@@ -0,0 +1,270 @@
+/**
+ * NUMA-Aware Channel Shards Implementation
+ */
+
+#define _GNU_SOURCE
+#include "channel_shards.h"
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+
+#define SHARD_MAX_CPUS 1024
+
+int shard_num_nodes(void) {
+    char path[64];
+    int nodes = 0;
+
+    while (nodes < SHARD_MAX_NODES) {
+        snprintf(path, sizeof(path), "/sys/devices/system/node/node%d", nodes);
+        if (access(path, F_OK) != 0) {
+            break;
+        }
+        nodes++;
+    }
+    return nodes > 0 ? nodes : 1;
+}
+
+int shard_cpu_node(int cpu) {
+    char path[64];
+
+    for (int node = 0; node < SHARD_MAX_NODES; node++) {
+        snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/node%d", cpu, node);
+        if (access(path, F_OK) == 0) {
+            return node;
+        }
+    }
+    return 0;
+}
+
+// Usable CPUs ordered node-interleaved: n0, n1, n0, n1, ...
+static int pick_cpus(int *cpus, int max) {
+    cpu_set_t allowed;
+    int by_node[SHARD_MAX_NODES][SHARD_MAX];
+    int per_node[SHARD_MAX_NODES] = {0};
+
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) {
+        return 0;
+    }
+
+    for (int cpu = 0; cpu < SHARD_MAX_CPUS && cpu < CPU_SETSIZE; cpu++) {
+        if (!CPU_ISSET(cpu, &allowed)) {
+            continue;
+        }
+        int node = shard_cpu_node(cpu);
+        if (per_node[node] < SHARD_MAX) {
+            by_node[node][per_node[node]++] = cpu;
+        }
+    }
+
+    int count = 0;
+    for (int round = 0; round < SHARD_MAX && count < max; round++) {
+        for (int node = 0; node < SHARD_MAX_NODES && count < max; node++) {
+            if (round < per_node[node]) {
+                cpus[count++] = by_node[node][round];
+            }
+        }
+    }
+
+    // More shards than CPUs: wrap around (shards share CPUs, same order)
+    for (int i = count; i < max && count > 0; i++) {
+        cpus[i] = cpus[i % count];
+    }
+    return count > 0 ? max : 0;
+}
+
+static void process_channel(ShardEngine *eng, ShardChannel *ch) {
+    eng->source(eng->user, ch->index, ch->in, SHARD_BLOCK);
+
+    for (uint16_t i = 0; i < SHARD_BLOCK; i++) {
+        cb_push(&ch->buffer, ch->in[i]);
+        int32_t filtered = ma_filter(&ch->filter, (int32_t)(ch->in[i] * 1000));
+        ch->out[i] = filtered / 1000.0f;
+    }
+}
+
+static void *shard_main(void *arg) {
+    Shard *sh = (Shard *)arg;
+    ShardEngine *eng = sh->engine;
+
+    // Pin before touching any shard memory
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(sh->cpu, &set);
+    sh->pinned = sched_setaffinity(0, sizeof(set), &set) == 0;
+
+    unsigned cpu = 0, node = 0;
+    if (syscall(SYS_getcpu, &cpu, &node, NULL) == 0) {
+        sh->node = (int)node;
+    } else {
+        sh->node = shard_cpu_node(sh->cpu);
+    }
+
+    sh->map_bytes = sh->num_channels * sizeof(ShardChannel);
+    void *mem = mmap(NULL, sh->map_bytes, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+    if (!sh->pinned || mem == MAP_FAILED) {
+        sh->channels = NULL;
+        atomic_fetch_add(&eng->failures, 1);
+    } else {
+        // First touch from the pinned thread: pages land on this node
+        sh->channels = (ShardChannel *)mem;
+        memset(mem, 0, sh->map_bytes);
+        for (uint32_t c = 0; c < sh->num_channels; c++) {
+            cb_init(&sh->channels[c].buffer);
+            ma_init(&sh->channels[c].filter);
+            sh->channels[c].index = sh->first_channel + c;
+        }
+    }
+
+    atomic_fetch_add(&eng->allocated, 1);
+    while (!atomic_load(&eng->go)) {
+        sched_yield();
+    }
+
+    if (sh->channels == NULL || atomic_load(&eng->failures) != 0) {
+        return NULL;
+    }
+
+    uint64_t samples = 0;
+    while (!atomic_load_explicit(&eng->stop, memory_order_relaxed)) {
+        for (uint32_t c = 0; c < sh->num_channels; c++) {
+            process_channel(eng, &sh->channels[c]);
+        }
+        samples += (uint64_t)sh->num_channels * SHARD_BLOCK;
+    }
+    sh->samples = samples;
+    return NULL;
+}
+
+bool shards_init(ShardEngine *eng, uint16_t num_shards, uint32_t num_channels,
+                 ShardSourceFn source, void *user) {
+    int cpus[SHARD_MAX];
+
+    if (num_shards == 0 || num_shards > SHARD_MAX || num_channels < num_shards) {
+        return false;
+    }
+    if (pick_cpus(cpus, num_shards) < num_shards) {
+        return false;
+    }
+
+    eng->num_shards = num_shards;
+    eng->source = source;
+    eng->user = user;
+    eng->run_seconds = 0.0;
+    atomic_init(&eng->allocated, 0);
+    atomic_init(&eng->go, false);
+    atomic_init(&eng->stop, false);
+    atomic_init(&eng->failures, 0);
+
+    uint32_t base = num_channels / num_shards;
+    uint32_t extra = num_channels % num_shards;
+    uint32_t next = 0;
+    uint16_t started = 0;
+
+    for (uint16_t i = 0; i < num_shards; i++) {
+        Shard *sh = &eng->shards[i];
+        sh->engine = eng;
+        sh->cpu = cpus[i];
+        sh->node = 0;
+        sh->pinned = false;
+        sh->first_channel = next;
+        sh->num_channels = base + (i < extra ? 1 : 0);
+        sh->channels = NULL;
+        sh->map_bytes = 0;
+        sh->samples = 0;
+        next += sh->num_channels;
+
+        if (pthread_create(&sh->thread, NULL, shard_main, sh) != 0) {
+            // A shard that never started cannot report in; stop here
+            atomic_fetch_add(&eng->failures, 1);
+            break;
+        }
+        started++;
+    }
+
+    struct timespec poll = { 0, 1000000 };
+    while (atomic_load(&eng->allocated) < started) {
+        nanosleep(&poll, NULL);
+    }
+    if (atomic_load(&eng->failures) == 0) {
+        return true;
+    }
+
+    // Release the workers (they see the failure and exit) and clean up
+    atomic_store(&eng->go, true);
+    for (uint16_t i = 0; i < started; i++) {
+        pthread_join(eng->shards[i].thread, NULL);
+    }
+    eng->num_shards = started;
+    shards_destroy(eng);
+    return false;
+}
+
+void shards_run(ShardEngine *eng, double seconds) {
+    struct timespec start, end;
+    struct timespec pause;
+
+    pause.tv_sec = (time_t)seconds;
+    pause.tv_nsec = (long)((seconds - (double)pause.tv_sec) * 1e9);
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    atomic_store(&eng->go, true);
+    nanosleep(&pause, NULL);
+    atomic_store(&eng->stop, true);
+
+    for (uint16_t i = 0; i < eng->num_shards; i++) {
+        pthread_join(eng->shards[i].thread, NULL);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    eng->run_seconds = (double)(end.tv_sec - start.tv_sec) +
+                       (double)(end.tv_nsec - start.tv_nsec) * 1e-9;
+}
+
+uint16_t shards_report(const ShardEngine *eng, ShardNodeReport *out, uint16_t max_nodes) {
+    uint16_t count = 0;
+
+    for (uint16_t i = 0; i < eng->num_shards; i++) {
+        const Shard *sh = &eng->shards[i];
+        uint16_t slot = 0;
+
+        while (slot < count && out[slot].node != sh->node) {
+            slot++;
+        }
+        if (slot == count) {
+            if (count == max_nodes) {
+                continue;
+            }
+            out[slot].node = sh->node;
+            out[slot].shards = 0;
+            out[slot].channels = 0;
+            out[slot].samples = 0;
+            count++;
+        }
+
+        out[slot].shards++;
+        out[slot].channels += sh->num_channels;
+        out[slot].samples += sh->samples;
+    }
+
+    for (uint16_t n = 0; n < count; n++) {
+        out[n].samples_per_sec = eng->run_seconds > 0.0
+                                 ? (double)out[n].samples / eng->run_seconds : 0.0;
+    }
+    return count;
+}
+
+void shards_destroy(ShardEngine *eng) {
+    for (uint16_t i = 0; i < eng->num_shards; i++) {
+        Shard *sh = &eng->shards[i];
+        if (sh->channels != NULL) {
+            munmap(sh->channels, sh->map_bytes);
+            sh->channels = NULL;
+        }
+    }
+}
@@ -0,0 +1,136 @@
+/**
+ * NUMA-Aware Channel Shards
+ * Multi-channel engine whose state lives on the node that processes it
+ *
+ * Channels are split into shards; each shard is owned by one worker
+ * thread pinned to one CPU. The worker pins itself first and only then
+ * maps and initializes its channel memory (CircularBuffer, filter state,
+ * input/output blocks), so the kernel's first-touch policy places every
+ * page on the worker's own node. No libnuma needed.
+ *
+ * Key points:
+ * - CPUs are handed out round-robin across nodes, so shards spread over
+ *   sockets instead of filling node 0 first
+ * - Each worker confirms its CPU and node with getcpu() after pinning
+ * - Hot loop touches only shard-local memory, no sharing between shards
+ * - Per-node throughput report after a run
+ *
+ * Linux only (sched_setaffinity, getcpu, sysfs node topology). Link with
+ * -pthread.
+ */
+
+#ifndef CHANNEL_SHARDS_H
+#define CHANNEL_SHARDS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include "circular_buffer.h"
+#include "moving_average.h"
+
+#define SHARD_MAX 64
+#define SHARD_MAX_NODES 8
+#define SHARD_BLOCK 256             // Samples per channel per pass
+
+typedef struct {
+    CircularBuffer buffer;
+    MovingAverage filter;
+    float in[SHARD_BLOCK];
+    float out[SHARD_BLOCK];
+    uint32_t index;                 // Channel number within the engine
+} ShardChannel;
+
+/**
+ * Fill one input block for a channel
+ * @param user Caller context
+ * @param channel Channel number
+ * @param dst Destination (shard-local memory)
+ * @param n Samples to write
+ */
+typedef void (*ShardSourceFn)(void *user, uint32_t channel, float *dst, uint16_t n);
+
+typedef struct ShardEngine ShardEngine;
+
+typedef struct {
+    ShardEngine *engine;
+    pthread_t thread;
+    int cpu;                        // Requested CPU
+    int node;                       // Node reported by getcpu() after pinning
+    bool pinned;
+    uint32_t first_channel;
+    uint32_t num_channels;
+    ShardChannel *channels;         // Mapped and first-touched by the owner thread
+    size_t map_bytes;
+    uint64_t samples;               // Processed during the run
+} Shard;
+
+typedef struct {
+    int node;
+    uint16_t shards;
+    uint32_t channels;
+    uint64_t samples;
+    double samples_per_sec;
+} ShardNodeReport;
+
+struct ShardEngine {
+    Shard shards[SHARD_MAX];
+    uint16_t num_shards;
+    ShardSourceFn source;
+    void *user;
+    atomic_int allocated;           // Workers done with pin + allocation
+    atomic_bool go;                 // Run released
+    atomic_bool stop;
+    atomic_int failures;            // Pin or allocation failures
+    double run_seconds;
+};
+
+/**
+ * Count NUMA nodes from sysfs
+ * @return Number of nodes (1 if topology is not exposed)
+ */
+int shard_num_nodes(void);
+
+/**
+ * Look up the node of a CPU from sysfs
+ * @param cpu CPU number
+ * @return Node number (0 if unknown)
+ */
+int shard_cpu_node(int cpu);
+
+/**
+ * Pin workers, allocate node-local shard state, wait for shards_run
+ * @param eng Pointer to ShardEngine
+ * @param num_shards Worker threads (<= SHARD_MAX; CPUs are shared beyond the usable count)
+ * @param num_channels Total channels, split evenly over shards
+ * @param source Input generator called per channel per pass
+ * @param user Passed to source
+ * @return true if every worker pinned and allocated its memory
+ */
+bool shards_init(ShardEngine *eng, uint16_t num_shards, uint32_t num_channels,
+                 ShardSourceFn source, void *user);
+
+/**
+ * Process all channels for a fixed time, then stop and join the workers
+ * @param eng Pointer to ShardEngine
+ * @param seconds Run duration
+ */
+void shards_run(ShardEngine *eng, double seconds);
+
+/**
+ * Summarize throughput per node (after shards_run)
+ * @param eng Pointer to ShardEngine
+ * @param out Report array
+ * @param max_nodes Capacity of out
+ * @return Number of nodes written
+ */
+uint16_t shards_report(const ShardEngine *eng, ShardNodeReport *out, uint16_t max_nodes);
+
+/**
+ * Unmap shard memory
+ * @param eng Pointer to ShardEngine
+ */
+void shards_destroy(ShardEngine *eng);
+
+#endif // CHANNEL_SHARDS_H
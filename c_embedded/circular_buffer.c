@@ -4,11 +4,23 @@
  */
 
 #include "circular_buffer.h"
+#include "dsp_dispatch.h"
+#include <string.h>
 
 void cb_init(CircularBuffer *cb) {
+    cb_init_policy(cb, CB_OVERWRITE_OLDEST);
+}
+
+void cb_init_policy(CircularBuffer *cb, CbOverflowPolicy policy) {
     cb->head = 0;
     cb->tail = 0;
     cb->count = 0;
+    cb->policy = policy;
+    cb->write_seq = 0;
+    cb->read_seq = 0;
+    cb->overwritten = 0;
+    cb->dropped = 0;
+    cb->refused = 0;
     
     // Optional: Initialize data to zero
     for (int i = 0; i < BUFFER_SIZE; i++) {
@@ -19,8 +31,20 @@ void cb_init(CircularBuffer *cb) {
 bool cb_push(CircularBuffer *cb, float value) {
     bool was_full = cb_is_full(cb);
     
+    if (was_full) {
+        if (cb->policy == CB_DROP_NEWEST) {
+            cb->dropped++;
+            return false;
+        }
+        if (cb->policy == CB_BLOCK_PRODUCER) {
+            cb->refused++;
+            return false;  // Caller keeps value and retries after a pop
+        }
+    }
+    
     // Write to head position
     cb->data[cb->head] = value;
+    cb->write_seq++;
     
     // Advance head (use bitwise AND for power-of-2 buffer size)
     cb->head = (cb->head + 1) & (BUFFER_SIZE - 1);
@@ -28,6 +52,8 @@ bool cb_push(CircularBuffer *cb, float value) {
     if (was_full) {
         // Overwrite oldest - advance tail too
         cb->tail = (cb->tail + 1) & (BUFFER_SIZE - 1);
+        cb->read_seq++;
+        cb->overwritten++;
         return false;  // Indicate overflow
     } else {
         cb->count++;
@@ -46,10 +72,38 @@ bool cb_pop(CircularBuffer *cb, float *value) {
     // Advance tail
     cb->tail = (cb->tail + 1) & (BUFFER_SIZE - 1);
     cb->count--;
+    cb->read_seq++;
+    
+    return true;
+}
+
+bool cb_pop_seq(CircularBuffer *cb, float *value, uint64_t *seq) {
+    *seq = cb->read_seq;
+    return cb_pop(cb, value);
+}
+
+bool cb_peek_seq(CircularBuffer *cb, uint64_t seq, float *value) {
+    if (seq < cb->read_seq || seq >= cb->write_seq) {
+        return false;
+    }
     
+    // Stored samples are contiguous in sequence, so the slot is direct
+    *value = cb->data[seq & (BUFFER_SIZE - 1)];
     return true;
 }
 
+uint64_t cb_read_seq(CircularBuffer *cb) {
+    return cb->read_seq;
+}
+
+uint64_t cb_write_seq(CircularBuffer *cb) {
+    return cb->write_seq;
+}
+
+uint64_t cb_lost(CircularBuffer *cb) {
+    return cb->overwritten + cb->dropped;
+}
+
 bool cb_is_empty(CircularBuffer *cb) {
     return cb->count == 0;
 }
@@ -72,24 +126,44 @@ bool cb_peek(CircularBuffer *cb, uint16_t index, float *value) {
     return true;
 }
 
+bool cb_copy(CircularBuffer *cb, uint16_t index, float *dst, uint16_t n) {
+    if ((uint32_t)index + n > cb->count) {
+        return false;
+    }
+    
+    // At most two contiguous runs: up to the end of storage, then from 0
+    uint16_t start = (cb->tail + index) & (BUFFER_SIZE - 1);
+    uint16_t first = BUFFER_SIZE - start;
+    if (first > n) {
+        first = n;
+    }
+    
+    memcpy(dst, &cb->data[start], first * sizeof(float));
+    memcpy(dst + first, &cb->data[0], (n - first) * sizeof(float));
+    return true;
+}
+
 float cb_mean(CircularBuffer *cb) {
     if (cb_is_empty(cb)) {
         return 0.0f;
     }
     
-    float sum = 0.0f;
-    uint16_t idx = cb->tail;
-    
-    for (uint16_t i = 0; i < cb->count; i++) {
-        sum += cb->data[idx];
-        idx = (idx + 1) & (BUFFER_SIZE - 1);
+    // Live data is at most two contiguous spans: [tail, end) and [0, head)
+    uint16_t first = BUFFER_SIZE - cb->tail;
+    if (first > cb->count) {
+        first = cb->count;
     }
     
+    float sum = dsp_kernels.sum_f32(&cb->data[cb->tail], first);
+    sum += dsp_kernels.sum_f32(&cb->data[0], cb->count - first);
+    
     return sum / cb->count;
 }
 
 void cb_clear(CircularBuffer *cb) {
-    cb->head = 0;
-    cb->tail = 0;
+    // Keep slot == seq % BUFFER_SIZE so cb_peek_seq stays direct
+    cb->head = (uint16_t)(cb->write_seq & (BUFFER_SIZE - 1));
+    cb->tail = cb->head;
     cb->count = 0;
+    cb->read_seq = cb->write_seq;
 }
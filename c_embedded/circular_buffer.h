@@ -5,7 +5,12 @@
  * Key advantages:
  * - Fixed memory allocation (no malloc in real-time code)
  * - O(1) insert and remove
- * - Automatic overwrite of old data
+ * - Automatic overwrite of old data (or drop-newest / block-producer)
+ * - 64-bit write/read sequence numbers: a reader that remembers the last
+ *   sequence it saw detects exactly how many samples were overwritten
+ *   and resynchronizes at cb_read_seq() without scanning
+ * - Sequences number stored samples; under CB_DROP_NEWEST the stored
+ *   stream stays gap-free and the discarded tail is counted in dropped
  */
 
 #ifndef CIRCULAR_BUFFER_H
@@ -16,24 +21,45 @@
 
 #define BUFFER_SIZE 256  // Power of 2 for efficient modulo
 
+typedef enum {
+    CB_OVERWRITE_OLDEST = 0,    // Default: keep the newest BUFFER_SIZE samples
+    CB_DROP_NEWEST,             // Keep what is buffered, discard new samples
+    CB_BLOCK_PRODUCER           // Refuse the sample; producer retries after a pop
+} CbOverflowPolicy;
+
 typedef struct {
     float data[BUFFER_SIZE];
     uint16_t head;       // Write position
     uint16_t tail;       // Read position
     uint16_t count;      // Number of elements
+    CbOverflowPolicy policy;
+    uint64_t write_seq;  // Sequence of the next stored sample
+    uint64_t read_seq;   // Sequence of the oldest stored sample
+    uint64_t overwritten;   // Samples lost under CB_OVERWRITE_OLDEST
+    uint64_t dropped;       // Samples lost under CB_DROP_NEWEST
+    uint64_t refused;       // Pushes refused under CB_BLOCK_PRODUCER (not lost)
 } CircularBuffer;
 
 /**
- * Initialize the buffer
+ * Initialize the buffer (overwrite-oldest policy)
  * @param cb Pointer to CircularBuffer structure
  */
 void cb_init(CircularBuffer *cb);
 
+/**
+ * Initialize the buffer with an overflow policy
+ * @param cb Pointer to CircularBuffer structure
+ * @param policy What cb_push does when the buffer is full
+ */
+void cb_init_policy(CircularBuffer *cb, CbOverflowPolicy policy);
+
 /**
  * Add element to buffer
  * @param cb Pointer to CircularBuffer
  * @param value Value to add
- * @return true if successful, false if buffer was full (overwrites oldest)
+ * @return true if stored with no loss; false if the buffer was full and,
+ *         per policy, the oldest was overwritten, value was dropped, or
+ *         value was refused (CB_BLOCK_PRODUCER: pop, then push it again)
  */
 bool cb_push(CircularBuffer *cb, float value);
 
@@ -45,6 +71,45 @@ bool cb_push(CircularBuffer *cb, float value);
  */
 bool cb_pop(CircularBuffer *cb, float *value);
 
+/**
+ * Remove oldest element along with its sequence number
+ * @param cb Pointer to CircularBuffer
+ * @param value Pointer to store the removed value
+ * @param seq Pointer to store its sequence (gap if > previous seq + 1)
+ * @return true if successful, false if buffer was empty
+ */
+bool cb_pop_seq(CircularBuffer *cb, float *value, uint64_t *seq);
+
+/**
+ * Read a sample by sequence number without removing it
+ * @param cb Pointer to CircularBuffer
+ * @param seq Sequence in [cb_read_seq, cb_write_seq)
+ * @param value Pointer to store the value
+ * @return false if seq was already overwritten/popped or not written yet
+ */
+bool cb_peek_seq(CircularBuffer *cb, uint64_t seq, float *value);
+
+/**
+ * Get sequence number of the oldest stored sample
+ * @param cb Pointer to CircularBuffer
+ * @return Read sequence
+ */
+uint64_t cb_read_seq(CircularBuffer *cb);
+
+/**
+ * Get sequence number the next stored sample will get
+ * @param cb Pointer to CircularBuffer
+ * @return Write sequence (total samples stored since init)
+ */
+uint64_t cb_write_seq(CircularBuffer *cb);
+
+/**
+ * Get number of samples lost to overflow (overwritten + dropped)
+ * @param cb Pointer to CircularBuffer
+ * @return Lost samples since init
+ */
+uint64_t cb_lost(CircularBuffer *cb);
+
 /**
  * Check if buffer is empty
  * @param cb Pointer to CircularBuffer
@@ -75,6 +140,16 @@ uint16_t cb_count(CircularBuffer *cb);
  */
 bool cb_peek(CircularBuffer *cb, uint16_t index, float *value);
 
+/**
+ * Copy a run of elements without removing them
+ * @param cb Pointer to CircularBuffer
+ * @param index Index from tail of the first element (0 = oldest)
+ * @param dst Destination array of n elements (oldest first)
+ * @param n Number of elements to copy
+ * @return true if the whole range was valid
+ */
+bool cb_copy(CircularBuffer *cb, uint16_t index, float *dst, uint16_t n);
+
 /**
  * Calculate mean of all elements in buffer
  * @param cb Pointer to CircularBuffer
@@ -83,7 +158,7 @@ bool cb_peek(CircularBuffer *cb, uint16_t index, float *value);
 float cb_mean(CircularBuffer *cb);
 
 /**
- * Clear the buffer
+ * Clear the buffer (sequence numbers keep counting)
  * @param cb Pointer to CircularBuffer
  */
 void cb_clear(CircularBuffer *cb);
@@ -0,0 +1,101 @@
+/**
+ * Disruptor-style Multi-consumer Ring Implementation
+ */
+
+#include "disruptor.h"
+
+#define DR_MASK (DR_SIZE - 1)
+
+static uint64_t min_consumer(Disruptor *dr, uint64_t limit) {
+    for (uint32_t i = 0; i < dr->n_consumers; i++) {
+        uint64_t c = atomic_load_explicit(&dr->consumers[i].seq, memory_order_acquire);
+        if (c < limit) {
+            limit = c;
+        }
+    }
+    return limit;
+}
+
+void dr_init(Disruptor *dr) {
+    for (uint32_t i = 0; i < DR_SIZE; i++) {
+        dr->data[i] = 0.0f;
+    }
+    atomic_init(&dr->published.seq, 0);
+    for (uint32_t i = 0; i < DR_MAX_CONSUMERS; i++) {
+        atomic_init(&dr->consumers[i].seq, 0);
+        dr->deps[i] = 0;
+    }
+    dr->n_consumers = 0;
+    dr->claimed = 0;
+    dr->gate_cache = 0;
+}
+
+int dr_add_consumer(Disruptor *dr, uint32_t dep_mask) {
+    uint32_t id = dr->n_consumers;
+
+    // Dependencies on earlier ids only, so the graph cannot have cycles
+    if (id >= DR_MAX_CONSUMERS || (dep_mask >> id) != 0) {
+        return -1;
+    }
+
+    dr->deps[id] = dep_mask;
+    atomic_store_explicit(&dr->consumers[id].seq,
+                          atomic_load_explicit(&dr->published.seq, memory_order_relaxed),
+                          memory_order_relaxed);
+    dr->n_consumers = id + 1;
+    return (int)id;
+}
+
+uint32_t dr_claim(Disruptor *dr, uint32_t n, float **slots) {
+    uint64_t next = dr->claimed;
+
+    // Rescan consumers only when the cached view says we would wrap
+    if (next + n - dr->gate_cache > DR_SIZE) {
+        dr->gate_cache = min_consumer(dr, next);
+    }
+
+    uint64_t free = DR_SIZE - (next - dr->gate_cache);
+    uint32_t to_end = DR_SIZE - (uint32_t)(next & DR_MASK);
+    if (n > free) {
+        n = (uint32_t)free;
+    }
+    if (n > to_end) {
+        n = to_end;
+    }
+
+    *slots = &dr->data[next & DR_MASK];
+    dr->claimed = next + n;
+    return n;
+}
+
+void dr_publish(Disruptor *dr) {
+    atomic_store_explicit(&dr->published.seq, dr->claimed, memory_order_release);
+}
+
+uint32_t dr_poll(Disruptor *dr, int id, float **slots) {
+    uint64_t pos = atomic_load_explicit(&dr->consumers[id].seq, memory_order_relaxed);
+    uint64_t barrier = atomic_load_explicit(&dr->published.seq, memory_order_acquire);
+
+    for (uint32_t mask = dr->deps[id]; mask != 0; mask &= mask - 1) {
+        uint64_t c = atomic_load_explicit(&dr->consumers[__builtin_ctz(mask)].seq,
+                                          memory_order_acquire);
+        if (c < barrier) {
+            barrier = c;
+        }
+    }
+
+    uint64_t avail = barrier - pos;
+    uint32_t to_end = DR_SIZE - (uint32_t)(pos & DR_MASK);
+
+    *slots = &dr->data[pos & DR_MASK];
+    return (avail < to_end) ? (uint32_t)avail : to_end;
+}
+
+void dr_release(Disruptor *dr, int id, uint32_t n) {
+    uint64_t pos = atomic_load_explicit(&dr->consumers[id].seq, memory_order_relaxed);
+    atomic_store_explicit(&dr->consumers[id].seq, pos + n, memory_order_release);
+}
+
+uint64_t dr_position(Disruptor *dr, int id) {
+    return atomic_load_explicit(&dr->consumers[id].seq, memory_order_acquire);
+}
@@ -0,0 +1,104 @@
+/**
+ * Disruptor-style Multi-consumer Ring
+ * One writer, several readers of the same sample stream, no copies
+ *
+ * The producer claims a run of slots, fills it in place and publishes it
+ * by advancing one cursor. Each consumer (filter, recorder, live view)
+ * has its own cursor and reads slots straight out of the ring. A consumer
+ * may depend on other consumers: it then never reads past the slowest of
+ * them, so the recorder can be made to trail the filter. The producer
+ * never laps the slowest consumer.
+ *
+ * Key points:
+ * - Single writer: claiming needs no atomic RMW, publish is one store
+ * - Claim/poll hand out contiguous spans, so stages work in batches
+ * - Every cursor sits on its own cache line; the producer caches the
+ *   slowest consumer and rescans only when it would otherwise wrap
+ * - An upstream stage may rewrite slots in place (e.g. filtered values);
+ *   stages depending on it see those writes, independent stages must not
+ *   read slots another stage writes
+ * - Non-blocking: claim/poll return 0 when there is nothing to do
+ */
+
+#ifndef DISRUPTOR_H
+#define DISRUPTOR_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+#define DR_SIZE 1024                // Power of 2
+#define DR_MAX_CONSUMERS 8
+
+typedef struct {
+    _Alignas(64) _Atomic uint64_t seq;  // Slots published / consumed so far
+} DrCursor;
+
+typedef struct {
+    float data[DR_SIZE];
+    DrCursor published;
+    DrCursor consumers[DR_MAX_CONSUMERS];
+    uint32_t deps[DR_MAX_CONSUMERS];    // Bitmask of consumers each one trails
+    uint32_t n_consumers;
+
+    // Producer-private
+    _Alignas(64) uint64_t claimed;      // Next slot to hand out
+    uint64_t gate_cache;                // Slowest consumer at last scan
+} Disruptor;
+
+/**
+ * Initialize an empty ring with no consumers
+ * @param dr Pointer to Disruptor
+ */
+void dr_init(Disruptor *dr);
+
+/**
+ * Register a consumer (before the producer starts)
+ * @param dr Pointer to Disruptor
+ * @param dep_mask Bitmask of earlier consumer ids this one must trail
+ *                 (0 = trails only the producer)
+ * @return Consumer id, or -1 if full or dep_mask names unknown consumers
+ */
+int dr_add_consumer(Disruptor *dr, uint32_t dep_mask);
+
+/**
+ * Claim up to n slots to write (producer)
+ * @param dr Pointer to Disruptor
+ * @param n Slots wanted
+ * @param slots Output: first claimed slot
+ * @return Contiguous slots claimed (0 if the slowest consumer is a lap behind)
+ */
+uint32_t dr_claim(Disruptor *dr, uint32_t n, float **slots);
+
+/**
+ * Publish every claimed slot to consumers (producer)
+ * @param dr Pointer to Disruptor
+ */
+void dr_publish(Disruptor *dr);
+
+/**
+ * Get the next run of slots this consumer may read
+ * @param dr Pointer to Disruptor
+ * @param id Consumer id
+ * @param slots Output: first readable slot
+ * @return Contiguous readable slots (0 if none yet)
+ */
+uint32_t dr_poll(Disruptor *dr, int id, float **slots);
+
+/**
+ * Mark slots as done so the producer and dependents can move on
+ * @param dr Pointer to Disruptor
+ * @param id Consumer id
+ * @param n Slots finished (at most the last dr_poll result)
+ */
+void dr_release(Disruptor *dr, int id, uint32_t n);
+
+/**
+ * Get the sequence number of a consumer's next slot
+ * @param dr Pointer to Disruptor
+ * @param id Consumer id
+ * @return Slots consumed so far
+ */
+uint64_t dr_position(Disruptor *dr, int id);
+
+#endif // DISRUPTOR_H
@@ -0,0 +1,76 @@
+/**
+ * Runtime CPU Feature Dispatch for DSP Kernels
+ * One binary, best kernel for the CPU it lands on
+ *
+ * Kernel families:
+ * - sum_f32  : ring statistics / moving averages
+ * - dot_f32  : FIR filters, correlation
+ * - cmag_f32 : FFT magnitude (interleaved complex -> |z|)
+ *
+ * The table starts out bound to the scalar reference, so kernels are
+ * safe to call before dsp_dispatch_init(). Call dsp_dispatch_init() once
+ * at startup to bind the best variant; set DSP_FORCE_ISA=scalar|sse4|
+ * avx2|avx512|neon in the environment (or call dsp_dispatch_force) to
+ * pin a specific variant for testing.
+ */
+
+#ifndef DSP_DISPATCH_H
+#define DSP_DISPATCH_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef enum {
+    DSP_ISA_SCALAR = 0,
+    DSP_ISA_SSE4,
+    DSP_ISA_AVX2,
+    DSP_ISA_AVX512,
+    DSP_ISA_NEON,
+    DSP_ISA_COUNT
+} DspIsa;
+
+typedef struct {
+    float (*sum_f32)(const float *x, uint32_t n);
+    float (*dot_f32)(const float *a, const float *b, uint32_t n);
+    void (*cmag_f32)(const float *cplx, float *mag, uint32_t n);
+    DspIsa isa;
+} DspKernels;
+
+// Currently bound kernels (read-only outside dsp_dispatch.c)
+extern DspKernels dsp_kernels;
+
+/**
+ * Detect CPU features and bind the best kernels
+ * Honors the DSP_FORCE_ISA environment variable.
+ * @return ISA that was bound
+ */
+DspIsa dsp_dispatch_init(void);
+
+/**
+ * Force a specific kernel variant
+ * @param isa Requested ISA
+ * @return true if the CPU supports it and it was bound
+ */
+bool dsp_dispatch_force(DspIsa isa);
+
+/**
+ * Check whether a variant can run on this CPU
+ * @param isa ISA to query
+ * @return true if supported (and compiled in)
+ */
+bool dsp_isa_supported(DspIsa isa);
+
+/**
+ * Get printable ISA name
+ * @param isa ISA
+ * @return Name such as "avx2"
+ */
+const char *dsp_isa_name(DspIsa isa);
+
+/**
+ * Compare every supported variant against the scalar reference
+ * @return Number of mismatching (variant, kernel) pairs, 0 if all agree
+ */
+int dsp_dispatch_selftest(void);
+
+#endif // DSP_DISPATCH_H
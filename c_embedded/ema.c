@@ -0,0 +1,141 @@
+/**
+ * Exponential Moving Average Implementation
+ */
+
+#include "ema.h"
+#include <math.h>
+
+float ema_alpha_from_tau(float tau_s, float sample_rate) {
+    return 1.0f - expf(-1.0f / (tau_s * sample_rate));
+}
+
+uint8_t ema_shift_from_tau(float tau_s, float sample_rate) {
+    float alpha = ema_alpha_from_tau(tau_s, sample_rate);
+    int k = (int)lroundf(-log2f(alpha));
+
+    if (k < 1) k = 1;
+    if (k > EMA_MAX_SHIFT) k = EMA_MAX_SHIFT;
+    return (uint8_t)k;
+}
+
+void ema_init(EmaFloat *ema, float alpha) {
+    ema->alpha = alpha;
+    ema->value = 0.0f;
+    ema->primed = false;
+}
+
+float ema_update(EmaFloat *ema, float x) {
+    if (!ema->primed) {
+        ema->value = x;
+        ema->primed = true;
+    } else {
+        ema->value += ema->alpha * (x - ema->value);
+    }
+    return ema->value;
+}
+
+void ema_int_init(EmaInt *ema, uint8_t shift) {
+    ema->sum = 0;
+    ema->shift = (shift > EMA_MAX_SHIFT) ? EMA_MAX_SHIFT : shift;
+    ema->primed = false;
+}
+
+int32_t ema_int_update(EmaInt *ema, int32_t x) {
+    if (!ema->primed) {
+        ema->sum = (int64_t)x * ((int64_t)1 << ema->shift);  // Multiply: << of negatives is UB
+        ema->primed = true;
+    } else {
+        // sum += x - sum * 2^-k  (sum holds value * 2^k)
+        ema->sum += x - (ema->sum >> ema->shift);
+    }
+    return (int32_t)(ema->sum >> ema->shift);
+}
+
+void ema_var_init(EmaVariance *ev, float alpha) {
+    ev->alpha = alpha;
+    ev->mean = 0.0f;
+    ev->var = 0.0f;
+    ev->primed = false;
+}
+
+void ema_var_update(EmaVariance *ev, float x) {
+    if (!ev->primed) {
+        ev->mean = x;
+        ev->var = 0.0f;
+        ev->primed = true;
+        return;
+    }
+
+    // West's incremental form: stable, no sum of squares
+    float diff = x - ev->mean;
+    float incr = ev->alpha * diff;
+    ev->mean += incr;
+    ev->var = (1.0f - ev->alpha) * (ev->var + diff * incr);
+}
+
+bool ema_bank_init(EmaBank *bank, const float *alphas, uint8_t count) {
+    if (count == 0 || count > EMA_BANK_SIZE) {
+        return false;
+    }
+
+    for (uint8_t i = 0; i < EMA_BANK_SIZE; i++) {
+        // Unused lanes get alpha 0 so the full-width loop leaves them alone
+        bank->alpha[i] = (i < count) ? alphas[i] : 0.0f;
+        bank->value[i] = 0.0f;
+    }
+    bank->count = count;
+    bank->primed = false;
+    return true;
+}
+
+void ema_bank_update(EmaBank *bank, float x) {
+    if (!bank->primed) {
+        for (uint8_t i = 0; i < EMA_BANK_SIZE; i++) {
+            bank->value[i] = x;
+        }
+        bank->primed = true;
+        return;
+    }
+
+    // Fixed trip count: compiles to one or two SIMD multiply-adds
+    for (int i = 0; i < EMA_BANK_SIZE; i++) {
+        bank->value[i] += bank->alpha[i] * (x - bank->value[i]);
+    }
+}
+
+bool ema_bank_int_init(EmaBankInt *bank, const uint8_t *shifts, uint8_t count) {
+    if (count == 0 || count > EMA_BANK_SIZE) {
+        return false;
+    }
+    for (uint8_t i = 0; i < count; i++) {
+        if (shifts[i] > EMA_MAX_SHIFT) {
+            return false;
+        }
+    }
+
+    for (uint8_t i = 0; i < EMA_BANK_SIZE; i++) {
+        bank->shift[i] = (i < count) ? shifts[i] : 0;
+        bank->sum[i] = 0;
+    }
+    bank->count = count;
+    bank->primed = false;
+    return true;
+}
+
+void ema_bank_int_update(EmaBankInt *bank, int32_t x) {
+    if (!bank->primed) {
+        for (int i = 0; i < EMA_BANK_SIZE; i++) {
+            bank->sum[i] = (int64_t)x * ((int64_t)1 << bank->shift[i]);
+        }
+        bank->primed = true;
+        return;
+    }
+
+    for (int i = 0; i < EMA_BANK_SIZE; i++) {
+        bank->sum[i] += x - (bank->sum[i] >> bank->shift[i]);
+    }
+}
+
+int32_t ema_bank_int_value(const EmaBankInt *bank, uint8_t index) {
+    return (int32_t)(bank->sum[index] >> bank->shift[index]);
+}
@@ -0,0 +1,158 @@
+/**
+ * Exponential Moving Average Family
+ * One-pole smoothing with O(1) memory for long time constants
+ *
+ * A 2^k-sample MovingAverage needs 2^k samples of history; an EMA with
+ * alpha = 2^-k has a similar time constant with one word of state.
+ *
+ * Variants:
+ * - EmaFloat    : y += alpha * (x - y)
+ * - EmaInt      : alpha = 2^-k, update is one shift, one add, one subtract
+ * - EmaVariance : exponentially weighted mean + variance
+ * - EmaBank     : several time constants updated per sample in one pass
+ */
+
+#ifndef EMA_H
+#define EMA_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define EMA_BANK_SIZE 8  // Time constants per bank
+#define EMA_MAX_SHIFT 30 // Largest k; any int32 input * 2^k fits the int64 sum
+
+typedef struct {
+    float alpha;
+    float value;
+    bool primed;        // First sample seeds the state (no startup ramp)
+} EmaFloat;
+
+typedef struct {
+    int64_t sum;        // value * 2^shift, keeps the fractional bits
+    uint8_t shift;      // alpha = 2^-shift
+    bool primed;
+} EmaInt;
+
+typedef struct {
+    float alpha;
+    float mean;
+    float var;
+    bool primed;
+} EmaVariance;
+
+typedef struct {
+    float alpha[EMA_BANK_SIZE];
+    float value[EMA_BANK_SIZE];
+    uint8_t count;
+    bool primed;
+} EmaBank;
+
+typedef struct {
+    int64_t sum[EMA_BANK_SIZE];
+    int64_t shift[EMA_BANK_SIZE];   // Same lane width as sum for variable-shift SIMD
+    uint8_t count;
+    bool primed;
+} EmaBankInt;
+
+/**
+ * Convert a time constant to alpha
+ * @param tau_s Time constant in seconds
+ * @param sample_rate Sample rate in Hz
+ * @return alpha = 1 - exp(-1 / (tau * fs))
+ */
+float ema_alpha_from_tau(float tau_s, float sample_rate);
+
+/**
+ * Nearest power-of-2 shift for a time constant
+ * @param tau_s Time constant in seconds
+ * @param sample_rate Sample rate in Hz
+ * @return k such that 2^-k is closest to the equivalent alpha (1..30)
+ */
+uint8_t ema_shift_from_tau(float tau_s, float sample_rate);
+
+/**
+ * Initialize float EMA
+ * @param ema Pointer to EmaFloat
+ * @param alpha Smoothing factor (0..1]
+ */
+void ema_init(EmaFloat *ema, float alpha);
+
+/**
+ * Update float EMA
+ * @param ema Pointer to EmaFloat
+ * @param x New sample
+ * @return Smoothed value
+ */
+float ema_update(EmaFloat *ema, float x);
+
+/**
+ * Initialize shift-only integer EMA
+ * @param ema Pointer to EmaInt
+ * @param shift alpha = 2^-shift (clamped to EMA_MAX_SHIFT); any int32
+ *              input is valid at any shift
+ */
+void ema_int_init(EmaInt *ema, uint8_t shift);
+
+/**
+ * Update integer EMA (shift + add, no multiply or divide)
+ * @param ema Pointer to EmaInt
+ * @param x New sample
+ * @return Smoothed value
+ */
+int32_t ema_int_update(EmaInt *ema, int32_t x);
+
+/**
+ * Initialize exponentially weighted mean/variance
+ * @param ev Pointer to EmaVariance
+ * @param alpha Smoothing factor (0..1]
+ */
+void ema_var_init(EmaVariance *ev, float alpha);
+
+/**
+ * Update exponentially weighted mean/variance
+ * @param ev Pointer to EmaVariance
+ * @param x New sample
+ */
+void ema_var_update(EmaVariance *ev, float x);
+
+/**
+ * Initialize a bank of float EMAs
+ * @param bank Pointer to EmaBank
+ * @param alphas Smoothing factors
+ * @param count Number of time constants (<= EMA_BANK_SIZE)
+ * @return true if count is valid
+ */
+bool ema_bank_init(EmaBank *bank, const float *alphas, uint8_t count);
+
+/**
+ * Update every time constant with one sample (single vectorizable pass)
+ * @param bank Pointer to EmaBank
+ * @param x New sample
+ */
+void ema_bank_update(EmaBank *bank, float x);
+
+/**
+ * Initialize a bank of shift-only integer EMAs
+ * @param bank Pointer to EmaBankInt
+ * @param shifts alpha = 2^-shift per entry
+ * @param count Number of time constants (<= EMA_BANK_SIZE)
+ * @return true if count is valid and every shift is <= EMA_MAX_SHIFT
+ */
+bool ema_bank_int_init(EmaBankInt *bank, const uint8_t *shifts, uint8_t count);
+
+/**
+ * Update every integer time constant with one sample
+ * @param bank Pointer to EmaBankInt
+ * @param x New sample
+ */
+void ema_bank_int_update(EmaBankInt *bank, int32_t x);
+
+/**
+ * Get one value of an integer bank
+ * @param bank Pointer to EmaBankInt
+ * @param index Entry index
+ * @return Smoothed value
+ */
+int32_t ema_bank_int_value(const EmaBankInt *bank, uint8_t index);
+
+#endif // EMA_H
@@ -0,0 +1,221 @@
+/**
+ * Pre-trigger Event Capture Implementation
+ */
+
+#include "event_capture.h"
+#include <string.h>
+
+static void finish_clip(EventCapture *ec, uint32_t slot) {
+    ec->active_mask &= ~(1u << slot);
+    atomic_store_explicit(&ec->clip_state[slot], EC_CLIP_READY, memory_order_relaxed);
+    // Queue publish (release) makes the clip and its samples visible
+    mpmc_try_enqueue(&ec->ready, slot);  // Capacity >> EC_MAX_CLIPS, cannot fail
+}
+
+bool ec_init(EventCapture *ec, BlockPool *pool, uint32_t pre_samples,
+             uint32_t post_samples) {
+    // Worst case the window straddles one extra block at each end
+    uint32_t span_blocks = (pre_samples + post_samples + BP_BLOCK_LEN - 1) / BP_BLOCK_LEN + 1;
+    if (pre_samples > (uint32_t)EC_HISTORY_BLOCKS * BP_BLOCK_LEN ||
+        span_blocks > EC_CLIP_MAX_BLOCKS) {
+        return false;
+    }
+
+    ec->pool = pool;
+    ec->pre_samples = pre_samples;
+    ec->post_samples = post_samples;
+    ec->hist_head = 0;
+    ec->hist_count = 0;
+    ec->current = NULL;
+    ec->sample_index = 0;
+    ec->active_mask = 0;
+    for (int i = 0; i < EC_MAX_CLIPS; i++) {
+        atomic_init(&ec->clip_state[i], EC_CLIP_FREE);
+    }
+    mpmc_init(&ec->ready);
+    ec->triggers = 0;
+    ec->triggers_dropped = 0;
+    ec->samples_dropped = 0;
+    return true;
+}
+
+bool ec_push(EventCapture *ec, float x) {
+    uint32_t mask;
+
+    if (ec->current == NULL) {
+        ec->current = bp_alloc(ec->pool);
+        if (ec->current == NULL) {
+            ec->samples_dropped++;
+            for (mask = ec->active_mask; mask != 0; mask &= mask - 1) {
+                ec->clips[__builtin_ctz(mask)].truncated = true;
+            }
+            return false;
+        }
+        ec->current->seq = (uint32_t)(ec->sample_index / BP_BLOCK_LEN);
+
+        // Every clip still collecting shares the new block
+        uint32_t idx = bp_index(ec->pool, ec->current);
+        for (mask = ec->active_mask; mask != 0; mask &= mask - 1) {
+            EventClip *clip = &ec->clips[__builtin_ctz(mask)];
+            bp_retain(ec->current);
+            clip->blocks[clip->n_blocks++] = idx;
+        }
+    }
+
+    PoolBlock *block = ec->current;
+    block->data[block->len++] = x;
+    ec->sample_index++;
+
+    for (mask = ec->active_mask; mask != 0; mask &= mask - 1) {
+        uint32_t slot = (uint32_t)__builtin_ctz(mask);
+        EventClip *clip = &ec->clips[slot];
+        clip->n_samples++;
+        if (--clip->post_remaining == 0) {
+            finish_clip(ec, slot);
+        }
+    }
+
+    if (block->len == BP_BLOCK_LEN) {
+        // Full block moves into history; the ring inherits the alloc ref
+        if (ec->hist_count == EC_HISTORY_BLOCKS) {
+            uint16_t oldest = (ec->hist_head + EC_HISTORY_BLOCKS - ec->hist_count)
+                              % EC_HISTORY_BLOCKS;
+            bp_release(ec->pool, bp_block(ec->pool, ec->history[oldest]));
+            ec->hist_count--;
+        }
+        ec->history[ec->hist_head] = bp_index(ec->pool, block);
+        ec->hist_head = (ec->hist_head + 1) % EC_HISTORY_BLOCKS;
+        ec->hist_count++;
+        ec->current = NULL;
+    }
+    return true;
+}
+
+bool ec_trigger(EventCapture *ec, uint32_t tag) {
+    uint32_t slot = EC_MAX_CLIPS;
+    for (uint32_t i = 0; i < EC_MAX_CLIPS; i++) {
+        if (atomic_load_explicit(&ec->clip_state[i], memory_order_acquire) == EC_CLIP_FREE) {
+            slot = i;
+            break;
+        }
+    }
+    if (slot == EC_MAX_CLIPS) {
+        ec->triggers_dropped++;
+        return false;
+    }
+
+    // Walk back from the newest block until the pre-trigger window is covered
+    uint32_t newest_first[EC_CLIP_MAX_BLOCKS];
+    uint16_t n = 0;
+    uint32_t remaining = ec->pre_samples;
+    uint32_t taken = 0;
+    uint16_t first_offset = 0;
+
+    if (ec->current != NULL) {
+        uint32_t avail = ec->current->len;
+        uint32_t take = (remaining < avail) ? remaining : avail;
+        newest_first[n++] = bp_index(ec->pool, ec->current);
+        first_offset = (uint16_t)(avail - take);
+        remaining -= take;
+        taken += take;
+    }
+    for (uint16_t h = 0; h < ec->hist_count && remaining > 0; h++) {
+        uint16_t pos = (ec->hist_head + EC_HISTORY_BLOCKS - 1 - h) % EC_HISTORY_BLOCKS;
+        uint32_t take = (remaining < BP_BLOCK_LEN) ? remaining : BP_BLOCK_LEN;
+        newest_first[n++] = ec->history[pos];
+        first_offset = (uint16_t)(BP_BLOCK_LEN - take);
+        remaining -= take;
+        taken += take;
+    }
+
+    EventClip *clip = &ec->clips[slot];
+    clip->n_blocks = n;
+    for (uint16_t i = 0; i < n; i++) {
+        clip->blocks[i] = newest_first[n - 1 - i];
+        bp_retain(bp_block(ec->pool, clip->blocks[i]));
+    }
+    clip->first_offset = first_offset;
+    clip->n_samples = taken;
+    clip->pre_samples = taken;
+    clip->post_remaining = ec->post_samples;
+    clip->trigger_sample = ec->sample_index;
+    clip->tag = tag;
+    clip->truncated = taken < ec->pre_samples;
+    ec->triggers++;
+
+    atomic_store_explicit(&ec->clip_state[slot], EC_CLIP_ACTIVE, memory_order_relaxed);
+    if (clip->post_remaining == 0) {
+        finish_clip(ec, slot);
+    } else {
+        ec->active_mask |= 1u << slot;
+    }
+    return true;
+}
+
+const EventClip *ec_next_clip(EventCapture *ec) {
+    uint32_t slot;
+    if (!mpmc_try_dequeue(&ec->ready, &slot)) {
+        return NULL;
+    }
+    return &ec->clips[slot];
+}
+
+const float *ec_clip_span(EventCapture *ec, const EventClip *clip, uint16_t i,
+                          uint32_t *len) {
+    // Blocks in a clip are contiguous: only the first starts mid-block
+    uint32_t start = (i == 0) ? clip->first_offset : 0;
+    uint32_t before = (i == 0) ? 0
+                               : (BP_BLOCK_LEN - clip->first_offset) + (uint32_t)(i - 1) * BP_BLOCK_LEN;
+    uint32_t left = (clip->n_samples > before) ? clip->n_samples - before : 0;
+    uint32_t span = BP_BLOCK_LEN - start;
+
+    *len = (left < span) ? left : span;
+    return &bp_block(ec->pool, clip->blocks[i])->data[start];
+}
+
+uint32_t ec_clip_copy(EventCapture *ec, const EventClip *clip, float *dst,
+                      uint32_t max) {
+    uint32_t out = 0;
+
+    for (uint16_t i = 0; i < clip->n_blocks && out < max; i++) {
+        uint32_t len;
+        const float *src = ec_clip_span(ec, clip, i, &len);
+        if (len > max - out) {
+            len = max - out;
+        }
+        memcpy(dst + out, src, len * sizeof(float));
+        out += len;
+    }
+    return out;
+}
+
+void ec_clip_release(EventCapture *ec, const EventClip *clip) {
+    uint32_t slot = (uint32_t)(clip - ec->clips);
+
+    for (uint16_t i = 0; i < clip->n_blocks; i++) {
+        bp_release(ec->pool, bp_block(ec->pool, clip->blocks[i]));
+    }
+    // Producer may reuse the slot once it sees FREE
+    atomic_store_explicit(&ec->clip_state[slot], EC_CLIP_FREE, memory_order_release);
+}
+
+void ec_destroy(EventCapture *ec) {
+    for (uint32_t i = 0; i < EC_MAX_CLIPS; i++) {
+        if (atomic_load_explicit(&ec->clip_state[i], memory_order_acquire) != EC_CLIP_FREE) {
+            ec_clip_release(ec, &ec->clips[i]);
+        }
+    }
+    mpmc_init(&ec->ready);
+    ec->active_mask = 0;
+
+    while (ec->hist_count > 0) {
+        uint16_t oldest = (ec->hist_head + EC_HISTORY_BLOCKS - ec->hist_count)
+                          % EC_HISTORY_BLOCKS;
+        bp_release(ec->pool, bp_block(ec->pool, ec->history[oldest]));
+        ec->hist_count--;
+    }
+    if (ec->current != NULL) {
+        bp_release(ec->pool, ec->current);
+        ec->current = NULL;
+    }
+}
@@ -0,0 +1,146 @@
+/**
+ * Pre-trigger Event Capture
+ * Clips of signal around arrhythmia / artifact triggers without copies
+ *
+ * The acquisition thread writes samples into pooled blocks (block_pool.h)
+ * and keeps the last EC_HISTORY_BLOCKS of them in a ring, the same way a
+ * CircularBuffer keeps its last BUFFER_SIZE samples. A trigger retains the
+ * blocks that cover the pre-trigger window instead of copying them, then
+ * retains each new block until the post-trigger samples are in. The
+ * finished clip is handed to consumer threads through an MPMC queue of
+ * clip indices (mpmc_queue.h).
+ *
+ * Key points:
+ * - Overlapping triggers share the same blocks; each clip only holds refs
+ * - History ring drops its ref to the oldest block as it advances, so a
+ *   block lives exactly as long as the ring or some clip needs it
+ * - Bounded: EC_MAX_CLIPS clip slots; triggers without a free slot and
+ *   samples without a free block are counted, never waited for
+ * - ec_push/ec_trigger run on one producer thread; any number of threads
+ *   may take and release finished clips
+ */
+
+#ifndef EVENT_CAPTURE_H
+#define EVENT_CAPTURE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include "block_pool.h"
+#include "mpmc_queue.h"
+
+#define EC_HISTORY_BLOCKS 16        // Ring of full blocks (pre-trigger depth)
+#define EC_MAX_CLIPS 8
+#define EC_CLIP_MAX_BLOCKS 32
+
+typedef enum {
+    EC_CLIP_FREE = 0,
+    EC_CLIP_ACTIVE,                 // Collecting post-trigger samples
+    EC_CLIP_READY                   // Queued or held by a consumer
+} EcClipState;
+
+typedef struct {
+    uint32_t blocks[EC_CLIP_MAX_BLOCKS];    // Pool indices, oldest first
+    uint16_t n_blocks;
+    uint16_t first_offset;          // Clip start within blocks[0]
+    uint32_t n_samples;             // Clip length so far
+    uint32_t pre_samples;           // Samples before the trigger
+    uint32_t post_remaining;
+    uint64_t trigger_sample;        // Capture sample index of the trigger
+    uint32_t tag;                   // Caller's reason code (e.g. RrEventType)
+    bool truncated;                 // Samples lost to pool exhaustion
+} EventClip;
+
+typedef struct {
+    BlockPool *pool;
+    uint32_t pre_samples;
+    uint32_t post_samples;
+
+    // History ring of full blocks (indices into pool)
+    uint32_t history[EC_HISTORY_BLOCKS];
+    uint16_t hist_head;
+    uint16_t hist_count;
+    PoolBlock *current;             // Block being filled, NULL until needed
+    uint64_t sample_index;          // Samples captured so far
+
+    EventClip clips[EC_MAX_CLIPS];
+    _Atomic uint8_t clip_state[EC_MAX_CLIPS];
+    uint32_t active_mask;           // Producer-private: clips in ACTIVE
+
+    MpmcQueue ready;                // Finished clip indices
+
+    uint64_t triggers;
+    uint64_t triggers_dropped;      // No free clip slot
+    uint64_t samples_dropped;       // No free pool block
+} EventCapture;
+
+/**
+ * Initialize capture over a block pool
+ * @param ec Pointer to EventCapture
+ * @param pool Initialized block pool shared with other stages
+ * @param pre_samples Samples kept before each trigger
+ * @param post_samples Samples collected after each trigger
+ * @return false if the window does not fit EC_HISTORY_BLOCKS/EC_CLIP_MAX_BLOCKS
+ */
+bool ec_init(EventCapture *ec, BlockPool *pool, uint32_t pre_samples,
+             uint32_t post_samples);
+
+/**
+ * Capture one sample (producer thread)
+ * @param ec Pointer to EventCapture
+ * @param x Sample value
+ * @return false if the sample was dropped (pool exhausted)
+ */
+bool ec_push(EventCapture *ec, float x);
+
+/**
+ * Start a clip around the most recent sample (producer thread)
+ * @param ec Pointer to EventCapture
+ * @param tag Caller's reason code, copied into the clip
+ * @return false if all clip slots are busy
+ */
+bool ec_trigger(EventCapture *ec, uint32_t tag);
+
+/**
+ * Take the next finished clip (any thread)
+ * @param ec Pointer to EventCapture
+ * @return Clip owned by the caller until ec_clip_release, or NULL
+ */
+const EventClip *ec_next_clip(EventCapture *ec);
+
+/**
+ * Get one contiguous span of a clip without copying
+ * @param ec Pointer to EventCapture
+ * @param clip Clip from ec_next_clip
+ * @param i Span index (0..clip->n_blocks-1)
+ * @param len Output span length in samples
+ * @return Pointer to the samples of span i
+ */
+const float *ec_clip_span(EventCapture *ec, const EventClip *clip, uint16_t i,
+                          uint32_t *len);
+
+/**
+ * Copy a clip into a flat array
+ * @param ec Pointer to EventCapture
+ * @param clip Clip from ec_next_clip
+ * @param dst Destination array
+ * @param max Capacity of dst
+ * @return Samples copied
+ */
+uint32_t ec_clip_copy(EventCapture *ec, const EventClip *clip, float *dst,
+                      uint32_t max);
+
+/**
+ * Drop the clip's block references and free its slot (any thread)
+ * @param ec Pointer to EventCapture
+ * @param clip Clip from ec_next_clip
+ */
+void ec_clip_release(EventCapture *ec, const EventClip *clip);
+
+/**
+ * Release every block and clip still held (no other thread may be active)
+ * @param ec Pointer to EventCapture
+ */
+void ec_destroy(EventCapture *ec);
+
+#endif // EVENT_CAPTURE_H
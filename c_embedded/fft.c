@@ -0,0 +1,104 @@
+/**
+ * Radix-2 FFT Implementation
+ * Iterative decimation-in-time, table driven
+ */
+
+#include "fft.h"
+#include <math.h>
+
+#define FFT_PI 3.14159265358979323846
+
+bool fft_init(FftPlan *plan, uint16_t n) {
+    if (n < 2 || n > FFT_MAX_SIZE || (n & (n - 1)) != 0) {
+        return false;
+    }
+
+    plan->n = n;
+    plan->log2n = 0;
+    while ((1u << plan->log2n) < n) {
+        plan->log2n++;
+    }
+
+    for (uint16_t k = 0; k < n / 2; k++) {
+        double angle = 2.0 * FFT_PI * k / n;
+        plan->cos_table[k] = (float)cos(angle);
+        plan->sin_table[k] = (float)sin(angle);
+    }
+
+    for (uint16_t i = 0; i < n; i++) {
+        uint16_t r = 0;
+        for (uint16_t b = 0; b < plan->log2n; b++) {
+            r |= ((i >> b) & 1u) << (plan->log2n - 1 - b);
+        }
+        plan->bitrev[i] = r;
+    }
+
+    return true;
+}
+
+// Shared butterfly pass; sign = -1 forward, +1 inverse
+static void fft_transform(const FftPlan *plan, float *data, float sign) {
+    uint16_t n = plan->n;
+
+    // Bit-reversal permutation
+    for (uint16_t i = 0; i < n; i++) {
+        uint16_t j = plan->bitrev[i];
+        if (j > i) {
+            float re = data[2 * i];
+            float im = data[2 * i + 1];
+            data[2 * i] = data[2 * j];
+            data[2 * i + 1] = data[2 * j + 1];
+            data[2 * j] = re;
+            data[2 * j + 1] = im;
+        }
+    }
+
+    // Butterflies
+    for (uint32_t size = 2; size <= n; size <<= 1) {
+        uint32_t half = size >> 1;
+        uint32_t stride = n / size;  // Twiddle step
+
+        for (uint32_t start = 0; start < n; start += size) {
+            for (uint32_t k = 0; k < half; k++) {
+                float wr = plan->cos_table[k * stride];
+                float wi = sign * plan->sin_table[k * stride];
+                uint32_t a = 2u * (start + k);
+                uint32_t b = 2u * (start + k + half);
+
+                float tr = wr * data[b] - wi * data[b + 1];
+                float ti = wr * data[b + 1] + wi * data[b];
+
+                data[b] = data[a] - tr;
+                data[b + 1] = data[a + 1] - ti;
+                data[a] += tr;
+                data[a + 1] += ti;
+            }
+        }
+    }
+}
+
+void fft_forward(const FftPlan *plan, float *data) {
+    fft_transform(plan, data, -1.0f);
+}
+
+void fft_inverse(const FftPlan *plan, float *data) {
+    fft_transform(plan, data, 1.0f);
+
+    float scale = 1.0f / plan->n;
+    for (uint32_t i = 0; i < 2u * plan->n; i++) {
+        data[i] *= scale;
+    }
+}
+
+void fft_load_real(const FftPlan *plan, const float *real, uint16_t len, float *data) {
+    uint16_t i = 0;
+
+    for (; i < len && i < plan->n; i++) {
+        data[2 * i] = real[i];
+        data[2 * i + 1] = 0.0f;
+    }
+    for (; i < plan->n; i++) {
+        data[2 * i] = 0.0f;
+        data[2 * i + 1] = 0.0f;
+    }
+}
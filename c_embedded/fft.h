@@ -0,0 +1,58 @@
+/**
+ * Radix-2 FFT with Reusable Plans
+ * In-place complex FFT for real-time spectral analysis
+ *
+ * Key points:
+ * - Twiddle factors and bit-reversal table computed once per plan
+ * - Fixed-size plan storage (no malloc)
+ * - Data is interleaved complex: re0, im0, re1, im1, ...
+ */
+
+#ifndef FFT_H
+#define FFT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define FFT_MAX_SIZE 4096  // Power of 2
+
+typedef struct {
+    uint16_t n;                             // Transform size (power of 2)
+    uint16_t log2n;
+    float cos_table[FFT_MAX_SIZE / 2];      // cos(2*pi*k/n)
+    float sin_table[FFT_MAX_SIZE / 2];      // sin(2*pi*k/n)
+    uint16_t bitrev[FFT_MAX_SIZE];
+} FftPlan;
+
+/**
+ * Build a plan for size n
+ * @param plan Pointer to FftPlan
+ * @param n Transform size, power of 2 in [2, FFT_MAX_SIZE]
+ * @return true if n is valid
+ */
+bool fft_init(FftPlan *plan, uint16_t n);
+
+/**
+ * In-place forward transform (no scaling)
+ * @param plan Initialized plan
+ * @param data Interleaved complex array of plan->n points
+ */
+void fft_forward(const FftPlan *plan, float *data);
+
+/**
+ * In-place inverse transform (scaled by 1/n)
+ * @param plan Initialized plan
+ * @param data Interleaved complex array of plan->n points
+ */
+void fft_inverse(const FftPlan *plan, float *data);
+
+/**
+ * Copy real samples into an interleaved complex buffer, zero-padding to n
+ * @param plan Initialized plan
+ * @param real Real input samples
+ * @param len Number of input samples (<= plan->n)
+ * @param data Interleaved complex output of plan->n points
+ */
+void fft_load_real(const FftPlan *plan, const float *real, uint16_t len, float *data);
+
+#endif // FFT_H
@@ -0,0 +1,261 @@
+/**
+ * Filter Design Implementation
+ * Bilinear-transform Butterworth, RBJ-style notch and windowed-sinc FIR
+ */
+
+#include "filter_design.h"
+#include <math.h>
+
+#define FD_PI 3.14159265358979323846
+
+// Shared Butterworth core: prewarped bilinear transform per section
+static int butter_design(SosSection *sos, int order, float cutoff_hz,
+                         float sample_rate, bool highpass) {
+    if (order < 1 || order > FD_MAX_ORDER ||
+        cutoff_hz <= 0.0f || cutoff_hz >= sample_rate / 2) {
+        return 0;
+    }
+
+    double k = tan(FD_PI * cutoff_hz / sample_rate);  // Prewarped cutoff
+    double k2 = k * k;
+    int n = 0;
+
+    // Conjugate pole pairs -> second-order sections
+    for (int i = 0; i < order / 2; i++) {
+        double theta = FD_PI * (2 * i + 1 + (order & 1)) / (2.0 * order);
+        double q = 1.0 / (2.0 * cos(theta));
+        double norm = 1.0 / (1.0 + k / q + k2);
+
+        if (highpass) {
+            sos[n].b0 = (float)norm;
+            sos[n].b1 = (float)(-2.0 * norm);
+            sos[n].b2 = (float)norm;
+        } else {
+            sos[n].b0 = (float)(k2 * norm);
+            sos[n].b1 = (float)(2.0 * k2 * norm);
+            sos[n].b2 = (float)(k2 * norm);
+        }
+        sos[n].a1 = (float)(2.0 * (k2 - 1.0) * norm);
+        sos[n].a2 = (float)((1.0 - k / q + k2) * norm);
+        n++;
+    }
+
+    // Odd order: remaining real pole -> first-order section
+    if (order & 1) {
+        double norm = 1.0 / (1.0 + k);
+
+        if (highpass) {
+            sos[n].b0 = (float)norm;
+            sos[n].b1 = (float)(-norm);
+        } else {
+            sos[n].b0 = (float)(k * norm);
+            sos[n].b1 = (float)(k * norm);
+        }
+        sos[n].b2 = 0.0f;
+        sos[n].a1 = (float)((k - 1.0) * norm);
+        sos[n].a2 = 0.0f;
+        n++;
+    }
+
+    return n;
+}
+
+int fd_butter_lowpass(SosSection *sos, int order, float cutoff_hz, float sample_rate) {
+    return butter_design(sos, order, cutoff_hz, sample_rate, false);
+}
+
+int fd_butter_highpass(SosSection *sos, int order, float cutoff_hz, float sample_rate) {
+    return butter_design(sos, order, cutoff_hz, sample_rate, true);
+}
+
+int fd_butter_bandpass(SosSection *sos, int order, float low_hz, float high_hz,
+                       float sample_rate) {
+    if (order < 1 || order > FD_MAX_ORDER / 2 || low_hz >= high_hz) {
+        return 0;
+    }
+
+    int n_hp = butter_design(sos, order, low_hz, sample_rate, true);
+    if (n_hp == 0) {
+        return 0;
+    }
+
+    int n_lp = butter_design(sos + n_hp, order, high_hz, sample_rate, false);
+    if (n_lp == 0) {
+        return 0;
+    }
+
+    return n_hp + n_lp;
+}
+
+bool fd_notch(SosSection *sos, float notch_hz, float quality_factor, float sample_rate) {
+    if (notch_hz <= 0.0f || notch_hz >= sample_rate / 2 || quality_factor <= 0.0f) {
+        return false;
+    }
+
+    double w0 = 2.0 * FD_PI * notch_hz / sample_rate;
+    double bw = w0 / quality_factor;
+    double gain = 1.0 / (1.0 + tan(bw / 2.0));
+    double c = cos(w0);
+
+    sos->b0 = (float)gain;
+    sos->b1 = (float)(-2.0 * gain * c);
+    sos->b2 = (float)gain;
+    sos->a1 = (float)(-2.0 * gain * c);
+    sos->a2 = (float)(2.0 * gain - 1.0);
+    return true;
+}
+
+bool fd_fir_lowpass(float *taps, int num_taps, float cutoff_hz, float sample_rate) {
+    if (num_taps < 1 || num_taps > FD_MAX_TAPS ||
+        cutoff_hz <= 0.0f || cutoff_hz >= sample_rate / 2) {
+        return false;
+    }
+
+    double fc = cutoff_hz / sample_rate;  // Cycles per sample
+    double center = (num_taps - 1) / 2.0;
+    double sum = 0.0;
+
+    for (int i = 0; i < num_taps; i++) {
+        double m = i - center;
+        double h = (m == 0.0) ? 2.0 * fc : sin(2.0 * FD_PI * fc * m) / (FD_PI * m);
+
+        // Hamming window
+        if (num_taps > 1) {
+            h *= 0.54 - 0.46 * cos(2.0 * FD_PI * i / (num_taps - 1));
+        }
+
+        taps[i] = (float)h;
+        sum += h;
+    }
+
+    // Unity gain at DC
+    for (int i = 0; i < num_taps; i++) {
+        taps[i] = (float)(taps[i] / sum);
+    }
+
+    return true;
+}
+
+bool fd_fir_highpass(float *taps, int num_taps, float cutoff_hz, float sample_rate) {
+    if ((num_taps & 1) == 0) {
+        return false;  // Even length has a forced zero at Nyquist
+    }
+
+    if (!fd_fir_lowpass(taps, num_taps, cutoff_hz, sample_rate)) {
+        return false;
+    }
+
+    // Spectral inversion: delta - lowpass
+    for (int i = 0; i < num_taps; i++) {
+        taps[i] = -taps[i];
+    }
+    taps[num_taps / 2] += 1.0f;
+
+    // Unity gain at Nyquist (alternating-sign sum)
+    double sum = 0.0;
+    for (int i = 0; i < num_taps; i++) {
+        sum += (i & 1) ? -taps[i] : taps[i];
+    }
+    for (int i = 0; i < num_taps; i++) {
+        taps[i] = (float)(taps[i] / sum);
+    }
+
+    return true;
+}
+
+static int32_t quantize(double value, double scale, int32_t min, int32_t max) {
+    double q = floor(value * scale + 0.5);
+
+    if (q > max) return max;
+    if (q < min) return min;
+    return (int32_t)q;
+}
+
+void fd_quantize_q15(const float *in, int16_t *out, int n) {
+    for (int i = 0; i < n; i++) {
+        out[i] = (int16_t)quantize(in[i], 32768.0, INT16_MIN, INT16_MAX);
+    }
+}
+
+void fd_quantize_q31(const float *in, int32_t *out, int n) {
+    for (int i = 0; i < n; i++) {
+        out[i] = quantize(in[i], 2147483648.0, INT32_MIN, INT32_MAX);
+    }
+}
+
+void fd_sos_to_q15(const SosSection *in, SosSectionQ15 *out, int n, int post_shift) {
+    double scale = ldexp(1.0, 15 - post_shift);
+
+    for (int i = 0; i < n; i++) {
+        out[i].b0 = (int16_t)quantize(in[i].b0, scale, INT16_MIN, INT16_MAX);
+        out[i].b1 = (int16_t)quantize(in[i].b1, scale, INT16_MIN, INT16_MAX);
+        out[i].b2 = (int16_t)quantize(in[i].b2, scale, INT16_MIN, INT16_MAX);
+        out[i].a1 = (int16_t)quantize(in[i].a1, scale, INT16_MIN, INT16_MAX);
+        out[i].a2 = (int16_t)quantize(in[i].a2, scale, INT16_MIN, INT16_MAX);
+    }
+}
+
+void fd_sos_to_q31(const SosSection *in, SosSectionQ31 *out, int n, int post_shift) {
+    double scale = ldexp(1.0, 31 - post_shift);
+
+    for (int i = 0; i < n; i++) {
+        out[i].b0 = quantize(in[i].b0, scale, INT32_MIN, INT32_MAX);
+        out[i].b1 = quantize(in[i].b1, scale, INT32_MIN, INT32_MAX);
+        out[i].b2 = quantize(in[i].b2, scale, INT32_MIN, INT32_MAX);
+        out[i].a1 = quantize(in[i].a1, scale, INT32_MIN, INT32_MAX);
+        out[i].a2 = quantize(in[i].a2, scale, INT32_MIN, INT32_MAX);
+    }
+}
+
+void fd_export_sos_c(FILE *out, const char *name, const SosSection *sos, int n) {
+    fprintf(out, "static const SosSection %s[%d] = {\n", name, n);
+    for (int i = 0; i < n; i++) {
+        fprintf(out, "    { %.9ef, %.9ef, %.9ef, %.9ef, %.9ef },\n",
+                sos[i].b0, sos[i].b1, sos[i].b2, sos[i].a1, sos[i].a2);
+    }
+    fprintf(out, "};\n");
+}
+
+void fd_export_fir_q15_c(FILE *out, const char *name, const int16_t *taps, int n) {
+    fprintf(out, "static const int16_t %s[%d] = {", name, n);
+    for (int i = 0; i < n; i++) {
+        fprintf(out, "%s%6d%s", (i % 8 == 0) ? "\n    " : " ", taps[i],
+                (i < n - 1) ? "," : "");
+    }
+    fprintf(out, "\n};\n");
+}
+
+void fd_export_fir_vhdl(FILE *out, const int16_t *taps, int n) {
+    fprintf(out, "    constant coefficients : coef_array := (\n");
+    for (int i = 0; i < n; i++) {
+        fprintf(out, "        to_signed(%d, COEF_WIDTH)%s  -- h[%d]\n",
+                taps[i], (i < n - 1) ? "," : " ", i);
+    }
+    fprintf(out, "    );\n");
+}
+
+void fd_sos_init(SosFilter *f, const SosSection *sections, uint8_t num_sections) {
+    f->sections = sections;
+    f->num_sections = num_sections;
+    fd_sos_reset(f);
+}
+
+float fd_sos_process(SosFilter *f, float x) {
+    for (uint8_t i = 0; i < f->num_sections; i++) {
+        const SosSection *s = &f->sections[i];
+        float y = s->b0 * x + f->z1[i];
+
+        f->z1[i] = s->b1 * x - s->a1 * y + f->z2[i];
+        f->z2[i] = s->b2 * x - s->a2 * y;
+        x = y;
+    }
+
+    return x;
+}
+
+void fd_sos_reset(SosFilter *f) {
+    for (int i = 0; i < FD_MAX_SECTIONS; i++) {
+        f->z1[i] = 0.0f;
+        f->z2[i] = 0.0f;
+    }
+}
@@ -0,0 +1,206 @@
+/**
+ * Filter Design Routines
+ * Butterworth, notch and windowed-sinc FIR coefficient design in plain C
+ *
+ * Mirrors the SciPy calls used in python/dsp_filters.py (signal.butter,
+ * signal.iirnotch, signal.firwin) so the same filters can run on target.
+ *
+ * Key points:
+ * - Pure functions of (sample rate, cutoff, order) - no hidden state
+ * - Fixed-size output arrays (no malloc)
+ * - Q15/Q31 quantization for fixed-point kernels
+ * - Export helpers that print read-only C tables and VHDL constants, so
+ *   coefficients are designed once on the host and baked into flash/ROM
+ */
+
+#ifndef FILTER_DESIGN_H
+#define FILTER_DESIGN_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+#define FD_MAX_ORDER    8                       // Max Butterworth order
+#define FD_MAX_SECTIONS FD_MAX_ORDER            // Enough for band-pass cascades
+#define FD_MAX_TAPS     255                     // Max FIR length
+
+/**
+ * One second-order section (biquad), a0 normalized to 1
+ * y[n] = b0*x[n] + b1*x[n-1] + b2*x[n-2] - a1*y[n-1] - a2*y[n-2]
+ */
+typedef struct {
+    float b0, b1, b2;
+    float a1, a2;
+} SosSection;
+
+/**
+ * Fixed-point biquad, coefficients scaled by 2^-post_shift
+ * (a1 can reach +/-2, which does not fit Q15/Q31 without the shift)
+ */
+typedef struct {
+    int16_t b0, b1, b2;
+    int16_t a1, a2;
+} SosSectionQ15;
+
+typedef struct {
+    int32_t b0, b1, b2;
+    int32_t a1, a2;
+} SosSectionQ31;
+
+/**
+ * Runtime cascade of biquads (Direct Form II transposed)
+ */
+typedef struct {
+    const SosSection *sections;
+    uint8_t num_sections;
+    float z1[FD_MAX_SECTIONS];
+    float z2[FD_MAX_SECTIONS];
+} SosFilter;
+
+/**
+ * Design Butterworth low-pass filter as second-order sections
+ * @param sos Output array (at least (order + 1) / 2 entries)
+ * @param order Filter order (1..FD_MAX_ORDER)
+ * @param cutoff_hz -3 dB cutoff frequency in Hz
+ * @param sample_rate Sample rate in Hz
+ * @return Number of sections written, 0 on invalid arguments
+ */
+int fd_butter_lowpass(SosSection *sos, int order, float cutoff_hz, float sample_rate);
+
+/**
+ * Design Butterworth high-pass filter as second-order sections
+ * @param sos Output array (at least (order + 1) / 2 entries)
+ * @param order Filter order (1..FD_MAX_ORDER)
+ * @param cutoff_hz -3 dB cutoff frequency in Hz
+ * @param sample_rate Sample rate in Hz
+ * @return Number of sections written, 0 on invalid arguments
+ */
+int fd_butter_highpass(SosSection *sos, int order, float cutoff_hz, float sample_rate);
+
+/**
+ * Design band-pass as a high-pass + low-pass Butterworth cascade
+ * @param sos Output array (at least order + 1 entries)
+ * @param order Order of each edge (1..FD_MAX_ORDER / 2)
+ * @param low_hz Lower cutoff in Hz
+ * @param high_hz Upper cutoff in Hz
+ * @param sample_rate Sample rate in Hz
+ * @return Number of sections written, 0 on invalid arguments
+ */
+int fd_butter_bandpass(SosSection *sos, int order, float low_hz, float high_hz,
+                       float sample_rate);
+
+/**
+ * Design second-order IIR notch (same response as scipy.signal.iirnotch)
+ * @param sos Output section
+ * @param notch_hz Frequency to remove in Hz
+ * @param quality_factor Q = notch_hz / bandwidth
+ * @param sample_rate Sample rate in Hz
+ * @return true if arguments were valid
+ */
+bool fd_notch(SosSection *sos, float notch_hz, float quality_factor, float sample_rate);
+
+/**
+ * Design Hamming-windowed sinc low-pass FIR (like scipy.signal.firwin)
+ * Coefficients are normalized to unity gain at DC.
+ * @param taps Output array of num_taps coefficients
+ * @param num_taps Filter length (1..FD_MAX_TAPS)
+ * @param cutoff_hz Cutoff frequency in Hz
+ * @param sample_rate Sample rate in Hz
+ * @return true if arguments were valid
+ */
+bool fd_fir_lowpass(float *taps, int num_taps, float cutoff_hz, float sample_rate);
+
+/**
+ * Design Hamming-windowed sinc high-pass FIR (spectral inversion)
+ * Coefficients are normalized to unity gain at Nyquist.
+ * @param taps Output array of num_taps coefficients
+ * @param num_taps Filter length, must be odd
+ * @param cutoff_hz Cutoff frequency in Hz
+ * @param sample_rate Sample rate in Hz
+ * @return true if arguments were valid
+ */
+bool fd_fir_highpass(float *taps, int num_taps, float cutoff_hz, float sample_rate);
+
+/**
+ * Quantize float coefficients to Q15 with rounding and saturation
+ * @param in Float coefficients
+ * @param out Q15 output
+ * @param n Number of coefficients
+ */
+void fd_quantize_q15(const float *in, int16_t *out, int n);
+
+/**
+ * Quantize float coefficients to Q31 with rounding and saturation
+ * @param in Float coefficients
+ * @param out Q31 output
+ * @param n Number of coefficients
+ */
+void fd_quantize_q31(const float *in, int32_t *out, int n);
+
+/**
+ * Quantize biquads to Q15, scaled by 2^-post_shift
+ * @param in Float sections
+ * @param out Q15 sections
+ * @param n Number of sections
+ * @param post_shift Headroom bits (1 is enough for Butterworth/notch)
+ */
+void fd_sos_to_q15(const SosSection *in, SosSectionQ15 *out, int n, int post_shift);
+
+/**
+ * Quantize biquads to Q31, scaled by 2^-post_shift
+ * @param in Float sections
+ * @param out Q31 sections
+ * @param n Number of sections
+ * @param post_shift Headroom bits (1 is enough for Butterworth/notch)
+ */
+void fd_sos_to_q31(const SosSection *in, SosSectionQ31 *out, int n, int post_shift);
+
+/**
+ * Print sections as a `static const SosSection name[]` C table
+ * @param out Output stream
+ * @param name Table identifier
+ * @param sos Sections
+ * @param n Number of sections
+ */
+void fd_export_sos_c(FILE *out, const char *name, const SosSection *sos, int n);
+
+/**
+ * Print Q15 FIR taps as a `static const int16_t name[]` C table
+ * @param out Output stream
+ * @param name Table identifier
+ * @param taps Q15 coefficients
+ * @param n Number of taps
+ */
+void fd_export_fir_q15_c(FILE *out, const char *name, const int16_t *taps, int n);
+
+/**
+ * Print Q15 FIR taps in the `coef_array` constant format of vhdl/fir_filter.vhd
+ * @param out Output stream
+ * @param taps Q15 coefficients
+ * @param n Number of taps (use as NUM_TAPS generic)
+ */
+void fd_export_fir_vhdl(FILE *out, const int16_t *taps, int n);
+
+/**
+ * Initialize a runtime biquad cascade over a (usually const) section table
+ * @param f Pointer to SosFilter
+ * @param sections Section table, must outlive the filter
+ * @param num_sections Number of sections (<= FD_MAX_SECTIONS)
+ */
+void fd_sos_init(SosFilter *f, const SosSection *sections, uint8_t num_sections);
+
+/**
+ * Filter one sample through the cascade
+ * @param f Pointer to SosFilter
+ * @param x Input sample
+ * @return Filtered sample
+ */
+float fd_sos_process(SosFilter *f, float x);
+
+/**
+ * Clear the filter state
+ * @param f Pointer to SosFilter
+ */
+void fd_sos_reset(SosFilter *f);
+
+#endif // FILTER_DESIGN_H
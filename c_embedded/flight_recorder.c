@@ -0,0 +1,264 @@
+/**
+ * Flight Recorder Implementation
+ */
+
+#define _POSIX_C_SOURCE 200809L
+#include "flight_recorder.h"
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#define FR_MAGIC "FLTR"
+#define FR_VERSION 1
+#define FR_HEADER_SIZE 4096
+
+static float empty_value(void) {
+    uint32_t bits = FR_EMPTY_BITS;
+    float f;
+    memcpy(&f, &bits, sizeof(f));
+    return f;
+}
+
+static bool is_empty(float x) {
+    uint32_t bits;
+    memcpy(&bits, &x, sizeof(bits));
+    return bits == FR_EMPTY_BITS;
+}
+
+// FNV-1a over the identifying fields and the valid samples
+static uint32_t block_checksum(const FrBlock *b, uint64_t seq) {
+    uint32_t h = 2166136261u;
+    uint64_t fields[3] = { seq, b->start_sample, b->len };
+    const uint8_t *p = (const uint8_t *)fields;
+
+    for (size_t i = 0; i < sizeof(fields); i++) {
+        h = (h ^ p[i]) * 16777619u;
+    }
+    p = (const uint8_t *)b->data;
+    for (size_t i = 0; i < b->len * sizeof(float); i++) {
+        h = (h ^ p[i]) * 16777619u;
+    }
+    return h;
+}
+
+static FrBlock *slot_of(FrChannel *c, uint32_t n_blocks, uint64_t seq) {
+    return &c->blocks[(seq - 1) % n_blocks];
+}
+
+static bool block_valid(const FrBlock *b, uint64_t seq) {
+    return atomic_load_explicit(&b->seq, memory_order_acquire) == seq &&
+           b->len > 0 && b->len <= FR_BLOCK_LEN && b->checksum == block_checksum(b, seq);
+}
+
+static void open_block(FlightRecorder *fr, FrChannel *c, uint64_t seq, uint64_t start) {
+    FrBlock *b = slot_of(c, fr->hdr->blocks_per_channel, seq);
+    float empty = empty_value();
+
+    // Invalidate first: a crash mid-reset must not leave a "sealed" block,
+    // nor a tail whose start matches while it still holds last lap's data
+    atomic_store_explicit(&b->seq, 0, memory_order_release);
+    b->start_sample = UINT64_MAX;
+    b->len = 0;
+    atomic_thread_fence(memory_order_release);
+    for (uint32_t i = 0; i < FR_BLOCK_LEN; i++) {
+        b->data[i] = empty;
+    }
+    atomic_thread_fence(memory_order_release);
+    b->start_sample = start;  // Tail is recognisable only once fully reset
+
+    c->cur = b;
+    c->fill = 0;
+    c->next_seq = seq;
+}
+
+static void seal_block(FlightRecorder *fr, FrChannel *c, uint32_t len) {
+    FrBlock *b = c->cur;
+    struct timespec ts;
+
+    clock_gettime(CLOCK_REALTIME, &ts);
+    b->len = len;
+    b->sealed_ns = (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+    b->checksum = block_checksum(b, c->next_seq);
+    atomic_store_explicit(&b->seq, c->next_seq, memory_order_release);
+
+    open_block(fr, c, c->next_seq + 1, b->start_sample + len);
+}
+
+void fr_seal(FlightRecorder *fr, uint32_t ch) {
+    seal_block(fr, &fr->channels[ch], fr->channels[ch].fill);
+}
+
+// Pick up where the previous run stopped: newest valid block, then its tail
+static void resume_channel(FlightRecorder *fr, FrChannel *c) {
+    uint32_t n = fr->hdr->blocks_per_channel;
+    uint64_t newest = 0;
+
+    for (uint32_t i = 0; i < n; i++) {
+        uint64_t seq = atomic_load_explicit(&c->blocks[i].seq, memory_order_acquire);
+        if (seq > newest && (seq - 1) % n == i && block_valid(&c->blocks[i], seq)) {
+            newest = seq;
+        }
+    }
+
+    uint64_t start = 0;
+    if (newest > 0) {
+        const FrBlock *b = slot_of(c, n, newest);
+        start = b->start_sample + b->len;
+    }
+
+    // Unsealed tail left by a crash: keep what was written and seal it
+    FrBlock *tail = slot_of(c, n, newest + 1);
+    if (atomic_load_explicit(&tail->seq, memory_order_acquire) == 0 &&
+        tail->start_sample == start) {
+        uint32_t len = 0;
+        while (len < FR_BLOCK_LEN && !is_empty(tail->data[len])) {
+            len++;
+        }
+        if (len > 0) {
+            c->cur = tail;
+            c->next_seq = newest + 1;
+            seal_block(fr, c, len);
+            return;
+        }
+    }
+
+    open_block(fr, c, newest + 1, start);
+}
+
+bool fr_open(FlightRecorder *fr, const char *path, uint32_t n_channels,
+             uint32_t blocks_per_channel, float sample_rate) {
+    if (n_channels == 0 || n_channels > FR_MAX_CHANNELS || blocks_per_channel < 2) {
+        return false;
+    }
+
+    size_t size = FR_HEADER_SIZE + (size_t)n_channels * blocks_per_channel * sizeof(FrBlock);
+    fr->fd = open(path, O_RDWR | O_CREAT, 0644);
+    if (fr->fd < 0) {
+        return false;
+    }
+
+    // Reuse the file only if it was written with the same geometry
+    FrFileHeader old;
+    struct stat st;
+    fr->recovered = fstat(fr->fd, &st) == 0 && (size_t)st.st_size == size &&
+                    pread(fr->fd, &old, sizeof(old), 0) == (ssize_t)sizeof(old) &&
+                    memcmp(old.magic, FR_MAGIC, 4) == 0 && old.version == FR_VERSION &&
+                    old.n_channels == n_channels &&
+                    old.blocks_per_channel == blocks_per_channel &&
+                    old.block_len == FR_BLOCK_LEN;
+
+    if (!fr->recovered && (ftruncate(fr->fd, 0) != 0 || ftruncate(fr->fd, (off_t)size) != 0)) {
+        close(fr->fd);
+        return false;
+    }
+
+    fr->map = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fr->fd, 0);
+    if (fr->map == MAP_FAILED) {
+        close(fr->fd);
+        return false;
+    }
+    fr->map_size = size;
+    fr->hdr = (FrFileHeader *)fr->map;
+
+    FrBlock *blocks = (FrBlock *)((uint8_t *)fr->map + FR_HEADER_SIZE);
+    for (uint32_t ch = 0; ch < n_channels; ch++) {
+        fr->channels[ch].blocks = blocks + (size_t)ch * blocks_per_channel;
+    }
+
+    if (!fr->recovered) {
+        // Mark every slot unwritten once, so tails can be found after a crash
+        float empty = empty_value();
+        for (size_t i = 0; i < (size_t)n_channels * blocks_per_channel; i++) {
+            atomic_init(&blocks[i].seq, 0);
+            blocks[i].start_sample = UINT64_MAX;
+            for (uint32_t k = 0; k < FR_BLOCK_LEN; k++) {
+                blocks[i].data[k] = empty;
+            }
+        }
+        fr->hdr->version = FR_VERSION;
+        fr->hdr->n_channels = n_channels;
+        fr->hdr->blocks_per_channel = blocks_per_channel;
+        fr->hdr->block_len = FR_BLOCK_LEN;
+        fr->hdr->open_count = 0;
+        memcpy(fr->hdr->magic, FR_MAGIC, 4);  // Last: header valid from here on
+    }
+    fr->hdr->sample_rate = sample_rate;
+    fr->hdr->open_count++;
+
+    for (uint32_t ch = 0; ch < n_channels; ch++) {
+        resume_channel(fr, &fr->channels[ch]);
+    }
+    return true;
+}
+
+uint32_t fr_recover(FlightRecorder *fr, uint32_t ch, float seconds, float *dst,
+                    uint32_t max, FrRecovery *info) {
+    FrChannel *c = &fr->channels[ch];
+    uint32_t n = fr->hdr->blocks_per_channel;
+    uint32_t want = (uint32_t)(seconds * fr->hdr->sample_rate);
+    if (want > max) {
+        want = max;
+    }
+
+    // Pass 1: walk back from the newest block until enough samples are covered
+    uint32_t live = (c->fill < want) ? c->fill : want;
+    uint32_t have = live;
+    uint32_t blocks = 0;
+    uint64_t expect_end = c->cur->start_sample;
+    bool gap = false;
+
+    // The slot of the block being written held seq next_seq - n, so at most n - 1 behind it
+    while (have < want && blocks + 1 < n && c->next_seq > blocks + 1) {
+        uint64_t seq = c->next_seq - 1 - blocks;
+        const FrBlock *b = slot_of(c, n, seq);
+        if (!block_valid(b, seq) || b->start_sample + b->len != expect_end) {
+            gap = true;
+            break;
+        }
+        have += (b->len < want - have) ? b->len : want - have;
+        expect_end = b->start_sample;
+        blocks++;
+    }
+
+    // Pass 2: copy oldest first
+    uint32_t out = 0;
+    uint64_t first = c->cur->start_sample + c->fill - live;
+    for (uint32_t k = blocks; k > 0; k--) {
+        const FrBlock *b = slot_of(c, n, c->next_seq - k);
+        uint32_t skip = 0;
+        if (k == blocks) {
+            // Oldest block may be only partly needed
+            uint32_t needed = have - live;
+            for (uint32_t j = 1; j < blocks; j++) {
+                needed -= slot_of(c, n, c->next_seq - j)->len;
+            }
+            skip = b->len - needed;
+            first = b->start_sample + skip;
+        }
+        memcpy(dst + out, b->data + skip, (b->len - skip) * sizeof(float));
+        out += b->len - skip;
+    }
+    memcpy(dst + out, c->cur->data + c->fill - live, live * sizeof(float));
+    out += live;
+
+    if (info != NULL) {
+        info->first_sample = first;
+        info->blocks_verified = blocks;
+        info->unverified_samples = live;
+        info->gap = gap;
+    }
+    return out;
+}
+
+bool fr_sync(FlightRecorder *fr) {
+    return msync(fr->map, fr->map_size, MS_SYNC) == 0;
+}
+
+void fr_close(FlightRecorder *fr) {
+    munmap(fr->map, fr->map_size);
+    close(fr->fd);
+    fr->map = NULL;
+}
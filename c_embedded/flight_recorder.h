@@ -0,0 +1,145 @@
+/**
+ * Flight Recorder
+ * Crash-persistent per-channel sample rings in a memory-mapped file
+ *
+ * Each channel owns a ring of fixed-size blocks inside one shared file
+ * mapping. Samples are stored straight into the mapped page, so when the
+ * process dies the kernel still holds them; after a restart fr_open()
+ * maps the same file and fr_recover() returns the last N seconds per
+ * channel without replaying any log.
+ *
+ * File layout:
+ *   header : "FLTR", version, geometry, sample rate, open count (4 KiB)
+ *   blocks : channel-major, blocks_per_channel FrBlocks per channel
+ *   FrBlock: seq, start_sample, seal time, len, checksum, samples
+ * Block seq k always lives in slot (k - 1) % blocks_per_channel, so the
+ * newest block and the chain behind it are found without sorting.
+ *
+ * Key points:
+ * - fr_push is one store into the mapping (plus a seal every block)
+ * - Sealing writes len and an FNV-1a checksum, then publishes seq last;
+ *   recovery stops at the first block whose seq or checksum is wrong
+ * - A freshly opened block has seq 0 and is pre-filled with a reserved
+ *   NaN, so after a crash fr_open finds the unsealed tail up to the first
+ *   unused slot and seals it before writing resumes
+ * - Survives process crashes as-is. Power loss or a kernel panic keeps
+ *   only what the last fr_sync wrote back, so call it from a housekeeping
+ *   thread (it blocks for the disk), never from the sampling loop
+ */
+
+#ifndef FLIGHT_RECORDER_H
+#define FLIGHT_RECORDER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <stddef.h>
+
+#define FR_BLOCK_LEN 256            // Samples per block
+#define FR_MAX_CHANNELS 16
+#define FR_EMPTY_BITS 0x7FC0DEADu   // Reserved NaN marking unwritten slots
+
+typedef struct {
+    _Atomic uint64_t seq;           // 1-based block number, 0 = being written
+    uint64_t start_sample;          // Channel sample index of data[0]
+    uint64_t sealed_ns;             // CLOCK_REALTIME at seal
+    uint32_t len;
+    uint32_t checksum;
+    _Alignas(64) float data[FR_BLOCK_LEN];
+} FrBlock;
+
+typedef struct {
+    char magic[4];
+    uint32_t version;
+    uint32_t n_channels;
+    uint32_t blocks_per_channel;
+    uint32_t block_len;
+    float sample_rate;
+    uint64_t open_count;            // Incremented by every fr_open
+} FrFileHeader;
+
+typedef struct {
+    FrBlock *blocks;                // This channel's ring inside the mapping
+    FrBlock *cur;                   // Block being filled
+    uint32_t fill;
+    uint64_t next_seq;              // Seq the current block gets when sealed
+} FrChannel;
+
+typedef struct {
+    int fd;
+    void *map;
+    size_t map_size;
+    FrFileHeader *hdr;
+    FrChannel channels[FR_MAX_CHANNELS];
+    bool recovered;                 // Existing file with matching geometry
+} FlightRecorder;
+
+typedef struct {
+    uint64_t first_sample;          // Channel sample index of dst[0]
+    uint32_t blocks_verified;
+    uint32_t unverified_samples;    // From the block still being written
+    bool gap;                       // Stopped early at a bad or missing block
+} FrRecovery;
+
+/**
+ * Open (or create) a flight-recorder file and map it
+ * @param fr Pointer to FlightRecorder
+ * @param path File path
+ * @param n_channels Channels (<= FR_MAX_CHANNELS)
+ * @param blocks_per_channel Ring depth per channel
+ * @param sample_rate Samples per second per channel
+ * @return false on I/O error or bad geometry
+ */
+bool fr_open(FlightRecorder *fr, const char *path, uint32_t n_channels,
+             uint32_t blocks_per_channel, float sample_rate);
+
+/**
+ * Seal a full block and open the next one (called by fr_push)
+ * @param fr Pointer to FlightRecorder
+ * @param ch Channel
+ */
+void fr_seal(FlightRecorder *fr, uint32_t ch);
+
+/**
+ * Append one sample to a channel
+ * @param fr Pointer to FlightRecorder
+ * @param ch Channel
+ * @param x Sample (must not be the FR_EMPTY_BITS NaN)
+ */
+static inline void fr_push(FlightRecorder *fr, uint32_t ch, float x) {
+    FrChannel *c = &fr->channels[ch];
+    c->cur->data[c->fill] = x;
+    if (++c->fill == FR_BLOCK_LEN) {
+        fr_seal(fr, ch);
+    }
+}
+
+/**
+ * Copy the most recent samples of a channel, oldest first
+ * @param fr Pointer to FlightRecorder
+ * @param ch Channel
+ * @param seconds How far back to go
+ * @param dst Destination array
+ * @param max Capacity of dst
+ * @param info Optional details (may be NULL)
+ * @return Samples copied
+ */
+uint32_t fr_recover(FlightRecorder *fr, uint32_t ch, float seconds, float *dst,
+                    uint32_t max, FrRecovery *info);
+
+/**
+ * Write the mapping back to disk and wait for it (msync MS_SYNC)
+ * Blocks for the device write of every dirty page, typically milliseconds;
+ * safe to call from another thread while fr_push keeps running
+ * @param fr Pointer to FlightRecorder
+ * @return false on error
+ */
+bool fr_sync(FlightRecorder *fr);
+
+/**
+ * Unmap and close (samples stay in the file)
+ * @param fr Pointer to FlightRecorder
+ */
+void fr_close(FlightRecorder *fr);
+
+#endif // FLIGHT_RECORDER_H
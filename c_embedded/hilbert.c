@@ -0,0 +1,186 @@
+/**
+ * Hilbert Transform Implementation
+ */
+
+#include "hilbert.h"
+#include <math.h>
+#include <stddef.h>
+
+#define HILBERT_PI 3.14159265358979323846
+
+bool hilbert_init(HilbertFir *hf, uint8_t taps, float sample_rate) {
+    if (taps < 3 || taps > HILBERT_MAX_TAPS || (taps & 1) == 0 || sample_rate <= 0.0f) {
+        return false;
+    }
+
+    hf->taps = taps;
+    hf->half = (taps - 1) / 2;
+    hf->sample_rate = sample_rate;
+
+    // Ideal response 2 / (pi k) for odd k, Hamming window
+    for (int k = 0; k <= hf->half; k++) {
+        double h = 0.0;
+        if (k & 1) {
+            double w = 0.54 + 0.46 * cos(HILBERT_PI * k / (hf->half + 1));
+            h = 2.0 / (HILBERT_PI * k) * w;
+        }
+        hf->coef[k] = (float)h;
+        hf->coef_q15[k] = (int16_t)lround(h * 32767.0);
+    }
+
+    for (int i = 0; i < 2 * HILBERT_MAX_TAPS; i++) {
+        hf->hist[i] = 0.0f;
+        hf->hist_q15[i] = 0;
+    }
+    hf->pos = 0;
+    hf->pos_q15 = 0;
+    hf->prev_re = hf->prev_im = 0.0f;
+    hf->prev_re_q15 = hf->prev_im_q15 = 0;
+    return true;
+}
+
+uint8_t hilbert_delay(const HilbertFir *hf) {
+    return hf->half;
+}
+
+void hilbert_process(HilbertFir *hf, float x, HilbertOutput *out) {
+    uint8_t n = hf->taps;
+
+    // Mirror write keeps hist[pos .. pos + n) contiguous, oldest first
+    hf->hist[hf->pos] = x;
+    hf->hist[hf->pos + n] = x;
+    uint8_t pos = (hf->pos + 1 == n) ? 0 : hf->pos + 1;
+    hf->pos = pos;
+
+    // Odd offsets only; even taps are exactly zero
+    const float *c = &hf->hist[pos + hf->half];
+    float im = 0.0f;
+    for (uint8_t k = 1; k <= hf->half; k += 2) {
+        im += hf->coef[k] * (c[-k] - c[k]);
+    }
+    float re = c[0];
+
+    out->envelope = sqrtf(re * re + im * im);
+
+    // Phase step = arg(z[n] * conj(z[n-1]))
+    float cross = im * hf->prev_re - re * hf->prev_im;
+    float dot = re * hf->prev_re + im * hf->prev_im;
+    out->inst_freq_hz = atan2f(cross, dot) * hf->sample_rate / (float)(2.0 * HILBERT_PI);
+
+    hf->prev_re = re;
+    hf->prev_im = im;
+}
+
+static uint32_t isqrt32(uint32_t v) {
+    uint32_t root = 0;
+    uint32_t bit = 1u << 30;
+
+    while (bit > v) {
+        bit >>= 2;
+    }
+    while (bit != 0) {
+        if (v >= root + bit) {
+            v -= root + bit;
+            root = (root >> 1) + bit;
+        } else {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    return root;
+}
+
+// atan2 in Q15 of pi (32768 = pi), max error ~0.0015 rad
+static int16_t atan2_q15(int64_t y, int64_t x) {
+    if (x == 0 && y == 0) {
+        return 0;
+    }
+
+    int64_t ax = x < 0 ? -x : x;
+    int64_t ay = y < 0 ? -y : y;
+    bool swap = ay > ax;
+    // z = min / max in Q15, 0..1
+    int32_t z = (int32_t)(swap ? (ax << 15) / ay : (ay << 15) / ax);
+
+    // atan(z) ~ pi/4 z + z (1 - z) (0.2447 + 0.0663 z), in Q15 of pi (pi/4 -> 8192)
+    int32_t poly = 2552 + ((692 * z) >> 15);
+    int32_t a = (int32_t)(((int64_t)8192 * z +
+                           (((int64_t)poly * z >> 15) * (32768 - z))) >> 15);
+
+    if (swap) a = 16384 - a;         // pi/2 - a
+    if (x < 0) a = 32768 - a;        // pi - a
+    if (y < 0) a = -a;
+    if (a > 32767) a = 32767;
+    return (int16_t)a;
+}
+
+void hilbert_process_q15(HilbertFir *hf, int16_t x, HilbertOutputQ15 *out) {
+    uint8_t n = hf->taps;
+
+    hf->hist_q15[hf->pos_q15] = x;
+    hf->hist_q15[hf->pos_q15 + n] = x;
+    uint8_t pos = (hf->pos_q15 + 1 == n) ? 0 : hf->pos_q15 + 1;
+    hf->pos_q15 = pos;
+
+    const int16_t *c = &hf->hist_q15[pos + hf->half];
+    int32_t acc = 0;
+    for (uint8_t k = 1; k <= hf->half; k += 2) {
+        acc += (int32_t)hf->coef_q15[k] * ((int32_t)c[-k] - c[k]);
+    }
+    acc = (acc + (1 << 14)) >> 15;
+    if (acc > INT16_MAX) acc = INT16_MAX;
+    if (acc < INT16_MIN) acc = INT16_MIN;
+
+    int16_t re = c[0];
+    int16_t im = (int16_t)acc;
+
+    uint32_t mag2 = (uint32_t)((int32_t)re * re) + (uint32_t)((int32_t)im * im);
+    uint32_t env = isqrt32(mag2);
+    out->envelope = (int16_t)(env > INT16_MAX ? INT16_MAX : env);
+
+    int64_t cross = (int64_t)im * hf->prev_re_q15 - (int64_t)re * hf->prev_im_q15;
+    int64_t dot = (int64_t)re * hf->prev_re_q15 + (int64_t)im * hf->prev_im_q15;
+    out->phase_step = atan2_q15(cross, dot);
+
+    hf->prev_re_q15 = re;
+    hf->prev_im_q15 = im;
+}
+
+void hilbert_analytic_block(const FftPlan *plan, const float *x, float *work,
+                            float sample_rate, float *envelope, float *inst_freq_hz) {
+    uint16_t n = plan->n;
+
+    fft_load_real(plan, x, n, work);
+    fft_forward(plan, work);
+
+    // One-sided spectrum: keep DC and Nyquist, double positive, zero negative
+    for (uint16_t k = 1; k < n / 2; k++) {
+        work[2 * k] *= 2.0f;
+        work[2 * k + 1] *= 2.0f;
+    }
+    for (uint16_t k = n / 2 + 1; k < n; k++) {
+        work[2 * k] = 0.0f;
+        work[2 * k + 1] = 0.0f;
+    }
+
+    fft_inverse(plan, work);
+
+    float scale = sample_rate / (float)(2.0 * HILBERT_PI);
+    for (uint16_t i = 0; i < n; i++) {
+        float re = work[2 * i];
+        float im = work[2 * i + 1];
+
+        if (envelope != NULL) {
+            envelope[i] = sqrtf(re * re + im * im);
+        }
+        if (inst_freq_hz != NULL) {
+            if (i == 0) {
+                inst_freq_hz[i] = 0.0f;
+            } else {
+                float pr = work[2 * i - 2];
+                float pi = work[2 * i - 1];
+                inst_freq_hz[i] = atan2f(im * pr - re * pi, re * pr + im * pi) * scale;
+            }
+        }
+    }
+}
@@ -0,0 +1,98 @@
+/**
+ * Hilbert Transform: Envelope and Instantaneous Frequency
+ * Streaming FIR Hilbert transformer + block FFT analytic signal
+ *
+ * Streaming mode: odd-length, Hamming-windowed type III FIR. Every even
+ * tap is exactly zero and the odd taps are antisymmetric, so
+ *   imag[n] = sum_{k odd} h[k] * (x[c - k] - x[c + k])
+ * needs only (M + 1) / 2 multiplies for 2M + 1 taps. The real part is the
+ * input delayed by M samples to line up with the filter's group delay.
+ *
+ * Offline mode: one-sided spectrum via FFT (exact analytic signal of a
+ * whole block).
+ *
+ * Outputs per sample: envelope |z| and instantaneous frequency from the
+ * phase step between consecutive analytic samples. Float and Q15 paths.
+ */
+
+#ifndef HILBERT_H
+#define HILBERT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "fft.h"
+
+#define HILBERT_MAX_TAPS 63             // Odd
+#define HILBERT_MAX_HALF (HILBERT_MAX_TAPS / 2)
+
+typedef struct {
+    float envelope;
+    float inst_freq_hz;
+} HilbertOutput;
+
+typedef struct {
+    int16_t envelope;                   // Same Q15 scale as the input
+    int16_t phase_step;                 // Phase increment, Q15 of pi rad/sample
+} HilbertOutputQ15;
+
+typedef struct {
+    uint8_t taps;                       // Odd, 3..HILBERT_MAX_TAPS
+    uint8_t half;                       // (taps - 1) / 2 = delay
+    float sample_rate;
+    float coef[HILBERT_MAX_HALF + 1];   // coef[k] for odd k (even entries unused)
+    int16_t coef_q15[HILBERT_MAX_HALF + 1];
+
+    float hist[2 * HILBERT_MAX_TAPS];   // Mirrored history
+    int16_t hist_q15[2 * HILBERT_MAX_TAPS];
+    uint8_t pos;
+    uint8_t pos_q15;
+
+    float prev_re, prev_im;
+    int16_t prev_re_q15, prev_im_q15;
+} HilbertFir;
+
+/**
+ * Design the FIR Hilbert transformer and clear history
+ * @param hf Pointer to HilbertFir
+ * @param taps Odd filter length (3..HILBERT_MAX_TAPS); longer = lower usable frequency
+ * @param sample_rate Sample rate in Hz
+ * @return true if parameters are valid
+ */
+bool hilbert_init(HilbertFir *hf, uint8_t taps, float sample_rate);
+
+/**
+ * Process one float sample
+ * @param hf Pointer to HilbertFir
+ * @param x Input sample
+ * @param out Envelope / instantaneous frequency for the sample delayed by hilbert_delay()
+ */
+void hilbert_process(HilbertFir *hf, float x, HilbertOutput *out);
+
+/**
+ * Process one Q15 sample (independent history from the float path)
+ * @param hf Pointer to HilbertFir
+ * @param x Input sample in Q15
+ * @param out Envelope / phase step for the sample delayed by hilbert_delay()
+ */
+void hilbert_process_q15(HilbertFir *hf, int16_t x, HilbertOutputQ15 *out);
+
+/**
+ * Get group delay in samples
+ * @param hf Pointer to HilbertFir
+ * @return (taps - 1) / 2
+ */
+uint8_t hilbert_delay(const HilbertFir *hf);
+
+/**
+ * Offline analytic signal of a whole block via FFT
+ * @param plan FFT plan, block length = plan->n
+ * @param x Real input of plan->n samples
+ * @param work Scratch of 2 * plan->n floats (holds the analytic signal on return)
+ * @param sample_rate Sample rate in Hz
+ * @param envelope Output envelope, plan->n samples (may be NULL)
+ * @param inst_freq_hz Output instantaneous frequency, plan->n samples (may be NULL)
+ */
+void hilbert_analytic_block(const FftPlan *plan, const float *x, float *work,
+                            float sample_rate, float *envelope, float *inst_freq_hz);
+
+#endif // HILBERT_H
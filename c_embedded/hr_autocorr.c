@@ -0,0 +1,135 @@
+/**
+ * Autocorrelation Heart-Rate Estimator Implementation
+ */
+
+#include "hr_autocorr.h"
+#include <stddef.h>
+
+bool hrac_init(HrAutocorr *hr, const HrAutocorrConfig *cfg, const FftPlan *plan) {
+    if (cfg->window_len < 4 || cfg->window_len > HRAC_MAX_WINDOW ||
+        plan->n < 2u * cfg->window_len || cfg->hop == 0 ||
+        cfg->min_bpm <= 0.0f || cfg->max_bpm <= cfg->min_bpm) {
+        return false;
+    }
+
+    uint32_t lag_min = (uint32_t)(cfg->sample_rate * 60.0f / cfg->max_bpm);
+    uint32_t lag_max = (uint32_t)(cfg->sample_rate * 60.0f / cfg->min_bpm + 0.5f);
+    if (lag_min < 1 || lag_max + lag_max / 8 + 1 >= cfg->window_len) {
+        return false;  // Window too short for the slowest heart rate
+    }
+
+    hr->cfg = *cfg;
+    hr->plan = plan;
+    hr->lag_min = (uint16_t)lag_min;
+    hr->lag_max = (uint16_t)lag_max;
+
+    for (int i = 0; i < HRAC_MAX_WINDOW; i++) {
+        hr->ring[i] = 0.0f;
+    }
+    hr->head = 0;
+    hr->fill = 0;
+    hr->since_hop = 0;
+    hr->bpm = 0.0f;
+    hr->confidence = 0.0f;
+    hr->valid = false;
+    return true;
+}
+
+static void hrac_estimate(HrAutocorr *hr) {
+    uint16_t w = hr->cfg.window_len;
+    uint16_t n = hr->plan->n;
+    uint16_t mask = HRAC_MAX_WINDOW - 1;
+    uint16_t idx = (hr->head - w) & mask;
+    float *work = hr->work;
+
+    float mean = 0.0f;
+    for (uint16_t i = 0; i < w; i++) {
+        mean += hr->ring[(idx + i) & mask];
+    }
+    mean /= w;
+
+    // Mean-removed window, zero padded to n
+    for (uint16_t i = 0; i < w; i++) {
+        work[2 * i] = hr->ring[(idx + i) & mask] - mean;
+        work[2 * i + 1] = 0.0f;
+    }
+    for (uint16_t i = w; i < n; i++) {
+        work[2 * i] = 0.0f;
+        work[2 * i + 1] = 0.0f;
+    }
+
+    // Wiener-Khinchin: autocorrelation = IFFT(|X|^2)
+    fft_forward(hr->plan, work);
+    for (uint16_t k = 0; k < n; k++) {
+        float re = work[2 * k];
+        float im = work[2 * k + 1];
+        work[2 * k] = re * re + im * im;
+        work[2 * k + 1] = 0.0f;
+    }
+    fft_inverse(hr->plan, work);
+
+    float r0 = work[0];
+    if (r0 <= 0.0f) {
+        hr->valid = false;
+        return;
+    }
+
+    // Peak pick on the biased estimate: its taper keeps sub-harmonic
+    // lags (2T, 3T) from tying with the true period
+    uint16_t best = hr->lag_min;
+    for (uint16_t lag = hr->lag_min; lag <= hr->lag_max; lag++) {
+        if (work[2 * lag] > work[2 * best]) {
+            best = lag;
+        }
+    }
+
+    // Refine on the unbiased estimate (scaled by w / (w - lag)) so the
+    // vertex is not pulled toward shorter lags. The peak spans hundreds of
+    // lags at typical rates, so fit over +/- best/8 instead of +/-1 to
+    // average out ripple from the window edges.
+    uint16_t d = best / 8;
+    if (d < 1) {
+        d = 1;
+    }
+    float a = work[2 * (best - d)] * w / (float)(w - best + d);
+    float b = work[2 * best] * w / (float)(w - best);
+    float c = work[2 * (best + d)] * w / (float)(w - best - d);
+    float denom = a - 2.0f * b + c;
+    float offset = (denom != 0.0f) ? 0.5f * (a - c) / denom : 0.0f;
+    if (offset > 0.5f) offset = 0.5f;
+    if (offset < -0.5f) offset = -0.5f;
+
+    hr->bpm = hr->cfg.sample_rate * 60.0f / (best + offset * d);
+    hr->confidence = work[2 * best] / r0;
+    hr->valid = hr->confidence > 0.0f;
+}
+
+bool hrac_push(HrAutocorr *hr, float x) {
+    hr->ring[hr->head] = x;
+    hr->head = (hr->head + 1) & (HRAC_MAX_WINDOW - 1);
+
+    if (hr->fill < hr->cfg.window_len) {
+        hr->fill++;
+    }
+    hr->since_hop++;
+
+    if (hr->fill == hr->cfg.window_len && hr->since_hop >= hr->cfg.hop) {
+        hr->since_hop = 0;
+        hrac_estimate(hr);
+        return true;
+    }
+
+    return false;
+}
+
+bool hrac_get(const HrAutocorr *hr, float *bpm, float *confidence) {
+    if (!hr->valid) {
+        return false;
+    }
+
+    *bpm = hr->bpm;
+    if (confidence != NULL) {
+        *confidence = hr->confidence;
+    }
+    return true;
+}
@@ -0,0 +1,74 @@
+/**
+ * Autocorrelation Heart-Rate Estimator
+ * Periodicity-based HR that survives missed or doubled peaks
+ *
+ * Every hop the latest window is mean-removed, zero-padded to a power of
+ * two >= 2x its length (so the circular correlation equals the linear
+ * one), and its autocorrelation is computed through the FFT
+ * (Wiener-Khinchin: r = IFFT(|FFT(x)|^2)). The strongest lag inside the
+ * physiological range is refined with parabolic interpolation.
+ *
+ * Cost per hop: one forward + one inverse FFT, regardless of window.
+ */
+
+#ifndef HR_AUTOCORR_H
+#define HR_AUTOCORR_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "fft.h"
+
+#define HRAC_MAX_WINDOW (FFT_MAX_SIZE / 2)  // Power of 2
+
+typedef struct {
+    float sample_rate;          // Hz
+    uint16_t window_len;        // Samples analysed (<= HRAC_MAX_WINDOW)
+    uint16_t hop;               // Samples between estimates
+    float min_bpm;              // Physiological search range
+    float max_bpm;
+} HrAutocorrConfig;
+
+typedef struct {
+    HrAutocorrConfig cfg;
+    const FftPlan *plan;        // plan->n >= 2 * window_len, shareable
+    uint16_t lag_min;
+    uint16_t lag_max;
+
+    float ring[HRAC_MAX_WINDOW];
+    uint16_t head;
+    uint16_t fill;
+    uint16_t since_hop;
+    float work[2 * FFT_MAX_SIZE];
+
+    float bpm;                  // Latest estimate
+    float confidence;           // Normalized autocorrelation at the peak (0..1)
+    bool valid;
+} HrAutocorr;
+
+/**
+ * Initialize the estimator
+ * @param hr Pointer to HrAutocorr
+ * @param cfg Configuration (copied)
+ * @param plan FFT plan with plan->n >= 2 * cfg->window_len
+ * @return true if configuration is valid
+ */
+bool hrac_init(HrAutocorr *hr, const HrAutocorrConfig *cfg, const FftPlan *plan);
+
+/**
+ * Push one sample
+ * @param hr Pointer to HrAutocorr
+ * @param x Sample value
+ * @return true if a new estimate was computed on this sample
+ */
+bool hrac_push(HrAutocorr *hr, float x);
+
+/**
+ * Get the latest heart-rate estimate
+ * @param hr Pointer to HrAutocorr
+ * @param bpm Heart rate output
+ * @param confidence Peak normalized autocorrelation output (may be NULL)
+ * @return true if an estimate is available
+ */
+bool hrac_get(const HrAutocorr *hr, float *bpm, float *confidence);
+
+#endif // HR_AUTOCORR_H
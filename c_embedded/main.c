@@ -5,22 +5,39 @@
  * 1. Circular buffer for data acquisition
  * 2. Moving average filter for noise reduction
  * 3. Simple peak detection
+ * 4. Autocorrelation heart rate (robust to missed peaks)
+ * 5. RR-interval rhythm alerts (brady / tachy / pause / irregular)
+ * 6. Metrics: overflows, dropped peaks, buffer depth, per-sample latency
  * 
- * Compile: gcc -o demo main.c circular_buffer.c moving_average.c -lm
- * Run: ./demo
+ * Compile: gcc -O2 -o demo main.c circular_buffer.c moving_average.c dsp_dispatch.c \
+ *          fft.c hr_autocorr.c rr_detector.c record_replay.c metrics.c -lm -pthread
+ * Run: ./demo [--seed N|time] [--record capture.rrpl] [--metrics]
+ *
+ * The noise seed is fixed by default so runs are repeatable; --record
+ * captures the simulated ADC stream for replay_tool; --metrics prints the
+ * full Prometheus exposition at the end.
  */
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <math.h>
+#include <string.h>
 #include <time.h>
 #include "circular_buffer.h"
 #include "moving_average.h"
+#include "dsp_dispatch.h"
+#include "fft.h"
+#include "hr_autocorr.h"
+#include "rr_detector.h"
+#include "record_replay.h"
+#include "metrics.h"
 
 #define SAMPLE_RATE 500
 #define SIGNAL_DURATION 5
 #define NUM_SAMPLES (SAMPLE_RATE * SIGNAL_DURATION)
 #define PI 3.14159265358979323846
+#define DEFAULT_SEED 12345u
+#define RECORD_BLOCK (SAMPLE_RATE / 10)  // 100 ms ADC blocks
 
 // Simulated ADC reading (in real embedded system, this reads from hardware)
 float read_adc_simulated(float time, float heart_rate_hz) {
@@ -65,13 +82,58 @@ int peak_detector_update(PeakDetector *pd, float value, int sample_num) {
     return is_peak;
 }
 
-int main() {
+int main(int argc, char *argv[]) {
+    unsigned int seed = DEFAULT_SEED;
+    const char *record_path = NULL;
+    bool dump_metrics = false;
+    
+    for (int a = 1; a < argc; a++) {
+        if (strcmp(argv[a], "--seed") == 0 && a + 1 < argc) {
+            a++;
+            seed = (strcmp(argv[a], "time") == 0) ? (unsigned int)time(NULL)
+                                                  : (unsigned int)strtoul(argv[a], NULL, 10);
+        } else if (strcmp(argv[a], "--record") == 0 && a + 1 < argc) {
+            record_path = argv[++a];
+        } else if (strcmp(argv[a], "--metrics") == 0) {
+            dump_metrics = true;
+        } else {
+            fprintf(stderr, "usage: %s [--seed N|time] [--record file] [--metrics]\n",
+                    argv[0]);
+            return 1;
+        }
+    }
+    
     printf("=========================================\n");
     printf("  Embedded Systems DSP Demo (C)\n");
     printf("=========================================\n\n");
     
-    // Seed random number generator
-    srand(time(NULL));
+    // Bind SIMD kernels for this CPU and verify them against scalar
+    DspIsa isa = dsp_dispatch_init();
+    int selftest_failures = dsp_dispatch_selftest();
+    printf("0. DSP kernels: %s (self-check %s)\n\n", dsp_isa_name(isa),
+           selftest_failures == 0 ? "passed" : "FAILED");
+    
+    // Seed random number generator (fixed unless --seed says otherwise)
+    srand(seed);
+    
+    RecWriter recorder;
+    float record_block[RECORD_BLOCK];
+    int record_fill = 0;
+    bool recording = false;
+    if (record_path != NULL) {
+        recording = rec_open(&recorder, record_path, SAMPLE_RATE, REC_ENC_F32, 1.0f);
+        if (!recording) {
+            fprintf(stderr, "cannot create %s\n", record_path);
+        }
+    }
+    
+    // Metrics (registered once, updated lock-free in the loop)
+    MetricId m_samples = metrics_counter("demo_samples_total");
+    MetricId m_overflow = metrics_counter("demo_cb_overflow_total");
+    MetricId m_peaks = metrics_counter("demo_peaks_total");
+    MetricId m_peaks_dropped = metrics_counter("demo_peaks_dropped_total");
+    MetricId m_depth = metrics_gauge("demo_cb_depth");
+    MetricId m_latency = metrics_histogram("demo_sample_process_ns");
     
     // Initialize components
     CircularBuffer buffer;
@@ -82,6 +144,18 @@ int main() {
     ma_init(&filter);
     peak_detector_init(&peak_det, 0.5f, SAMPLE_RATE / 3);  // Max 180 BPM
     
+    // Autocorrelation HR: 2048-sample window (~4 s), new estimate every 250 ms
+    static FftPlan hr_plan;
+    static HrAutocorr hr_est;
+    HrAutocorrConfig hr_cfg = { SAMPLE_RATE, 2048, SAMPLE_RATE / 4, 40.0f, 180.0f };
+    fft_init(&hr_plan, 4096);
+    hrac_init(&hr_est, &hr_cfg, &hr_plan);
+    
+    // Rhythm alerts: brady < 50, tachy > 120, pause > 2 s, nRMSSD > 0.10
+    static RrDetector rhythm;
+    RrDetectorConfig rr_cfg = { SAMPLE_RATE, 50.0f, 120.0f, 2000.0f, 0.10f, 250.0f };
+    rr_init(&rhythm, &rr_cfg);
+    
     float heart_rate_hz = 72.0f / 60.0f;  // 72 BPM
     
     printf("1. Simulating %d seconds of data acquisition at %d Hz\n", 
@@ -104,8 +178,23 @@ int main() {
         float raw_value = read_adc_simulated(time, heart_rate_hz);
         raw_samples[i] = raw_value;
         
-        // Add to circular buffer
-        cb_push(&buffer, raw_value);
+        if (recording) {
+            record_block[record_fill++] = raw_value;
+            if (record_fill == RECORD_BLOCK) {
+                // Timestamp = arrival of the block's last sample
+                uint64_t t_ns = (uint64_t)(i + 1) * 1000000000ull / SAMPLE_RATE;
+                rec_write_block(&recorder, t_ns, record_block, RECORD_BLOCK);
+                record_fill = 0;
+            }
+        }
+        
+        uint64_t t_start = metrics_now_ns();
+        
+        // Add to circular buffer (false = full, oldest sample overwritten)
+        if (!cb_push(&buffer, raw_value)) {
+            metrics_inc(m_overflow);
+        }
+        metrics_gauge_set(m_depth, cb_count(&buffer));
         
         // Apply moving average filter
         int32_t raw_int = (int32_t)(raw_value * 1000);  // Scale for integer filter
@@ -115,14 +204,31 @@ int main() {
         
         // Peak detection
         if (peak_detector_update(&peak_det, filtered_value, i)) {
+            metrics_inc(m_peaks);
             if (peak_count < 100) {
                 peak_samples[peak_count++] = i;
+            } else {
+                metrics_inc(m_peaks_dropped);
             }
+            rr_push_beat(&rhythm, (uint32_t)i);
         }
+        rr_tick(&rhythm, (uint32_t)i);
+        
+        hrac_push(&hr_est, filtered_value);
+        
+        metrics_inc(m_samples);
+        metrics_observe(m_latency, metrics_now_ns() - t_start);
     }
     
-    printf("   Processed %d samples\n", NUM_SAMPLES);
+    printf("   Processed %d samples (seed %u)\n", NUM_SAMPLES, seed);
+    if (recording && rec_close(&recorder)) {
+        printf("   Recorded input to %s\n", record_path);
+    }
     printf("   Buffer mean: %.3f\n", cb_mean(&buffer));
+    printf("   Buffer holds samples %llu-%llu (%llu older ones overwritten)\n",
+           (unsigned long long)cb_read_seq(&buffer),
+           (unsigned long long)cb_write_seq(&buffer) - 1,
+           (unsigned long long)cb_lost(&buffer));
     
     // Calculate noise reduction
     float raw_variance = 0, filtered_variance = 0;
@@ -168,6 +274,46 @@ int main() {
         printf("   Error: %.1f BPM\n", fabsf(detected_hr - 72.0f));
     }
     
+    float ac_hr, ac_conf;
+    if (hrac_get(&hr_est, &ac_hr, &ac_conf)) {
+        printf("   Autocorrelation heart rate: %.1f BPM (confidence %.2f)\n",
+               ac_hr, ac_conf);
+        printf("   Error: %.1f BPM\n", fabsf(ac_hr - 72.0f));
+    }
+    
+    printf("\n5. Rhythm Monitor:\n");
+    printf("   Short-term rate: %.1f BPM, irregularity (nRMSSD): %.3f\n",
+           rr_mean_bpm(&rhythm), rr_irregularity(&rhythm));
+    
+    RrEvent ev;
+    int event_count = 0;
+    while (rr_event_pop(&rhythm, &ev)) {
+        printf("   [%6.2f s] %s %s (%.2f)\n", (float)ev.sample_index / SAMPLE_RATE,
+               rr_event_name(ev.type), ev.onset ? "started" : "ended", ev.value);
+        event_count++;
+    }
+    if (event_count == 0) {
+        printf("   No rhythm alerts\n");
+    }
+    
+    static MetricsSnapshot snap;
+    metrics_snapshot(&snap);
+    printf("\n6. Metrics:\n");
+    printf("   Samples: %llu, buffer overflows: %llu, buffer depth: %lld\n",
+           (unsigned long long)snap.counters[m_samples],
+           (unsigned long long)snap.counters[m_overflow], (long long)snap.gauges[m_depth]);
+    printf("   Peaks: %llu (dropped %llu)\n", (unsigned long long)snap.counters[m_peaks],
+           (unsigned long long)snap.counters[m_peaks_dropped]);
+    if (snap.hist_count[m_latency] > 0) {
+        printf("   Mean per-sample processing: %.0f ns\n",
+               (double)snap.hist_sum[m_latency] / snap.hist_count[m_latency]);
+    }
+    if (dump_metrics) {
+        static char text[16384];
+        metrics_format_prometheus(&snap, text, sizeof(text));
+        printf("\n%s", text);
+    }
+    
     printf("\n=========================================\n");
     printf("  Demo Complete!\n");
     printf("=========================================\n");
@@ -0,0 +1,289 @@
+/**
+ * Metrics Registry Implementation
+ */
+
+#define _POSIX_C_SOURCE 200809L
+#include "metrics.h"
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+
+#define METRICS_TEXT_SIZE 65536
+#define METRICS_HTTP_TIMEOUT_MS 1000    // Per-client read/write limit
+
+MetricsShard metrics_shards[METRICS_SHARDS + 1];
+_Atomic int64_t metrics_gauges[METRICS_MAX_GAUGES];
+_Thread_local MetricsShard *metrics_tls_shard = NULL;
+_Thread_local bool metrics_tls_exclusive = false;
+
+static atomic_uint next_shard = 0;
+
+static uint16_t num_counters = 0;
+static uint16_t num_gauges = 0;
+static uint16_t num_histograms = 0;
+static const char *counter_names[METRICS_MAX_COUNTERS];
+static const char *gauge_names[METRICS_MAX_GAUGES];
+static const char *histogram_names[METRICS_MAX_HISTOGRAMS];
+
+MetricsShard *metrics_thread_shard(void) {
+    unsigned idx = atomic_fetch_add(&next_shard, 1);
+
+    // Shards are never handed back, so the first owner stays sole writer
+    metrics_tls_exclusive = idx < METRICS_SHARDS;
+    metrics_tls_shard = &metrics_shards[metrics_tls_exclusive ? idx : METRICS_SHARDS];
+    return metrics_tls_shard;
+}
+
+MetricId metrics_counter(const char *name) {
+    if (num_counters >= METRICS_MAX_COUNTERS) {
+        return METRICS_INVALID;
+    }
+    counter_names[num_counters] = name;
+    return num_counters++;
+}
+
+MetricId metrics_gauge(const char *name) {
+    if (num_gauges >= METRICS_MAX_GAUGES) {
+        return METRICS_INVALID;
+    }
+    gauge_names[num_gauges] = name;
+    return num_gauges++;
+}
+
+MetricId metrics_histogram(const char *name) {
+    if (num_histograms >= METRICS_MAX_HISTOGRAMS) {
+        return METRICS_INVALID;
+    }
+    histogram_names[num_histograms] = name;
+    return num_histograms++;
+}
+
+void metrics_snapshot(MetricsSnapshot *snap) {
+    snap->num_counters = num_counters;
+    snap->num_gauges = num_gauges;
+    snap->num_histograms = num_histograms;
+
+    for (uint16_t c = 0; c < num_counters; c++) {
+        uint64_t total = 0;
+        for (int s = 0; s <= METRICS_SHARDS; s++) {
+            total += atomic_load_explicit(&metrics_shards[s].counters[c], memory_order_relaxed);
+        }
+        snap->counter_names[c] = counter_names[c];
+        snap->counters[c] = total;
+    }
+
+    for (uint16_t g = 0; g < num_gauges; g++) {
+        snap->gauge_names[g] = gauge_names[g];
+        snap->gauges[g] = atomic_load_explicit(&metrics_gauges[g], memory_order_relaxed);
+    }
+
+    for (uint16_t h = 0; h < num_histograms; h++) {
+        uint64_t count = 0, sum = 0;
+
+        for (int b = 0; b < METRICS_HIST_BUCKETS; b++) {
+            uint64_t n = 0;
+            for (int s = 0; s <= METRICS_SHARDS; s++) {
+                n += atomic_load_explicit(&metrics_shards[s].hist[h].buckets[b],
+                                          memory_order_relaxed);
+            }
+            snap->hist_buckets[h][b] = n;
+            count += n;
+        }
+        for (int s = 0; s <= METRICS_SHARDS; s++) {
+            sum += atomic_load_explicit(&metrics_shards[s].hist[h].sum, memory_order_relaxed);
+        }
+
+        snap->histogram_names[h] = histogram_names[h];
+        snap->hist_count[h] = count;
+        snap->hist_sum[h] = sum;
+    }
+}
+
+// snprintf that tracks position and never runs past cap
+static void append(char *buf, size_t cap, size_t *pos, const char *fmt, ...) {
+    if (*pos + 1 >= cap) {
+        return;
+    }
+
+    va_list ap;
+    va_start(ap, fmt);
+    int n = vsnprintf(buf + *pos, cap - *pos, fmt, ap);
+    va_end(ap);
+
+    if (n > 0) {
+        *pos += ((size_t)n < cap - *pos) ? (size_t)n : cap - *pos - 1;
+    }
+}
+
+size_t metrics_format_prometheus(const MetricsSnapshot *snap, char *buf, size_t cap) {
+    size_t pos = 0;
+
+    if (cap == 0) {
+        return 0;
+    }
+    buf[0] = '\0';
+
+    for (uint16_t c = 0; c < snap->num_counters; c++) {
+        append(buf, cap, &pos, "# TYPE %s counter\n%s %llu\n",
+               snap->counter_names[c], snap->counter_names[c],
+               (unsigned long long)snap->counters[c]);
+    }
+
+    for (uint16_t g = 0; g < snap->num_gauges; g++) {
+        append(buf, cap, &pos, "# TYPE %s gauge\n%s %lld\n",
+               snap->gauge_names[g], snap->gauge_names[g], (long long)snap->gauges[g]);
+    }
+
+    for (uint16_t h = 0; h < snap->num_histograms; h++) {
+        const char *name = snap->histogram_names[h];
+        uint64_t cumulative = 0;
+
+        // Highest non-empty bucket bounds the output
+        int last = METRICS_HIST_BUCKETS - 1;
+        while (last > 0 && snap->hist_buckets[h][last] == 0) {
+            last--;
+        }
+
+        append(buf, cap, &pos, "# TYPE %s histogram\n", name);
+        for (int b = 0; b <= last; b++) {
+            cumulative += snap->hist_buckets[h][b];
+            uint64_t le = (b == 0) ? 0 : ((1ull << b) - 1);
+            append(buf, cap, &pos, "%s_bucket{le=\"%llu\"} %llu\n", name,
+                   (unsigned long long)le, (unsigned long long)cumulative);
+        }
+        append(buf, cap, &pos, "%s_bucket{le=\"+Inf\"} %llu\n%s_sum %llu\n%s_count %llu\n",
+               name, (unsigned long long)snap->hist_count[h],
+               name, (unsigned long long)snap->hist_sum[h],
+               name, (unsigned long long)snap->hist_count[h]);
+    }
+
+    return pos;
+}
+
+uint64_t metrics_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+// --- HTTP endpoint -------------------------------------------------------
+
+static int http_fd = -1;
+static pthread_t http_thread;
+static atomic_bool http_running = false;
+
+static void serve_one(int client) {
+    static MetricsSnapshot snap;
+    static char body[METRICS_TEXT_SIZE];
+    char request[1024];
+    char header[160];
+
+    // Any request gets the metrics; read it so the client sees a clean close
+    ssize_t r = read(client, request, sizeof(request) - 1);
+    if (r <= 0) {
+        return;  // Closed, error, or silent past the receive timeout
+    }
+    request[r] = '\0';
+
+    bool found = strncmp(request, "GET /metrics", 12) == 0 ||
+                 strncmp(request, "GET / ", 6) == 0;
+
+    size_t len = 0;
+    if (found) {
+        metrics_snapshot(&snap);
+        len = metrics_format_prometheus(&snap, body, sizeof(body));
+    }
+
+    int hlen = snprintf(header, sizeof(header),
+                        "HTTP/1.0 %s\r\n"
+                        "Content-Type: text/plain; version=0.0.4\r\n"
+                        "Content-Length: %zu\r\n\r\n",
+                        found ? "200 OK" : "404 Not Found", len);
+
+    if (write(client, header, (size_t)hlen) == hlen && len > 0) {
+        size_t sent = 0;
+        while (sent < len) {
+            ssize_t w = write(client, body + sent, len - sent);
+            if (w <= 0) {
+                break;
+            }
+            sent += (size_t)w;
+        }
+    }
+}
+
+static void *http_main(void *arg) {
+    (void)arg;
+
+    while (atomic_load(&http_running)) {
+        int client = accept(http_fd, NULL, NULL);
+        if (client < 0) {
+            continue;  // Woken by shutdown() in metrics_http_stop
+        }
+
+        // A silent or stalled client must not pin the only server thread
+        struct timeval tv = { METRICS_HTTP_TIMEOUT_MS / 1000,
+                              (METRICS_HTTP_TIMEOUT_MS % 1000) * 1000 };
+        setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+        setsockopt(client, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+
+        serve_one(client);
+        close(client);
+    }
+    return NULL;
+}
+
+bool metrics_http_start(uint16_t port) {
+    struct sockaddr_in addr;
+    int one = 1;
+
+    if (atomic_load(&http_running)) {
+        return false;
+    }
+
+    http_fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (http_fd < 0) {
+        return false;
+    }
+    setsockopt(http_fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);  // Local scrape only
+
+    if (bind(http_fd, (struct sockaddr *)&addr, sizeof(addr)) != 0 ||
+        listen(http_fd, 8) != 0) {
+        close(http_fd);
+        http_fd = -1;
+        return false;
+    }
+
+    atomic_store(&http_running, true);
+    if (pthread_create(&http_thread, NULL, http_main, NULL) != 0) {
+        atomic_store(&http_running, false);
+        close(http_fd);
+        http_fd = -1;
+        return false;
+    }
+    return true;
+}
+
+void metrics_http_stop(void) {
+    if (!atomic_load(&http_running)) {
+        return;
+    }
+
+    atomic_store(&http_running, false);
+    shutdown(http_fd, SHUT_RDWR);  // Unblocks accept()
+    pthread_join(http_thread, NULL);
+    close(http_fd);
+    http_fd = -1;
+}
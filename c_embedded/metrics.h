@@ -0,0 +1,190 @@
+/**
+ * Metrics Registry
+ * Counters, gauges and log2 histograms for the processing core
+ *
+ * Key points:
+ * - Metrics are registered once at startup and referenced by small ids
+ * - Counters and histograms are sharded per thread (cache-line aligned).
+ *   The first METRICS_SHARDS threads own their shard outright, so an
+ *   update is a relaxed load + store (no lock prefix, no false sharing);
+ *   any later threads share one overflow shard with atomic adds
+ * - Histograms use power-of-2 buckets (bucket = bit length of the value)
+ * - Readers sum the shards: snapshot API for in-process use, Prometheus
+ *   text format for scraping, optional local HTTP endpoint
+ *
+ * Hot-path calls are static inline; registration, snapshot and export
+ * live in metrics.c. The HTTP endpoint is POSIX sockets + pthreads.
+ */
+
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdatomic.h>
+
+#define METRICS_MAX_COUNTERS 32
+#define METRICS_MAX_GAUGES 16
+#define METRICS_MAX_HISTOGRAMS 8
+#define METRICS_HIST_BUCKETS 40     // Bucket b holds [2^(b-1), 2^b - 1], b = 0 holds 0
+#define METRICS_SHARDS 16           // Exclusive shards; one more is shared by the rest
+#define METRICS_INVALID 0xFFFF
+
+typedef uint16_t MetricId;
+
+typedef struct {
+    _Atomic uint64_t buckets[METRICS_HIST_BUCKETS];
+    _Atomic uint64_t sum;
+} MetricsHistShard;
+
+typedef struct {
+    _Alignas(64) _Atomic uint64_t counters[METRICS_MAX_COUNTERS];
+    MetricsHistShard hist[METRICS_MAX_HISTOGRAMS];
+} MetricsShard;
+
+typedef struct {
+    uint16_t num_counters;
+    uint16_t num_gauges;
+    uint16_t num_histograms;
+    const char *counter_names[METRICS_MAX_COUNTERS];
+    const char *gauge_names[METRICS_MAX_GAUGES];
+    const char *histogram_names[METRICS_MAX_HISTOGRAMS];
+    uint64_t counters[METRICS_MAX_COUNTERS];
+    int64_t gauges[METRICS_MAX_GAUGES];
+    uint64_t hist_buckets[METRICS_MAX_HISTOGRAMS][METRICS_HIST_BUCKETS];
+    uint64_t hist_count[METRICS_MAX_HISTOGRAMS];
+    uint64_t hist_sum[METRICS_MAX_HISTOGRAMS];
+} MetricsSnapshot;
+
+// Storage behind the inline hot path (read-only outside metrics.c/.h)
+extern MetricsShard metrics_shards[METRICS_SHARDS + 1];
+extern _Atomic int64_t metrics_gauges[METRICS_MAX_GAUGES];
+extern _Thread_local MetricsShard *metrics_tls_shard;
+extern _Thread_local bool metrics_tls_exclusive;
+
+/**
+ * Assign the calling thread a shard (slow path of metrics_shard)
+ * @return Shard pointer
+ */
+MetricsShard *metrics_thread_shard(void);
+
+static inline MetricsShard *metrics_shard(void) {
+    MetricsShard *s = metrics_tls_shard;
+    return (s != NULL) ? s : metrics_thread_shard();
+}
+
+// Single-writer cells skip the locked read-modify-write
+static inline void metrics_cell_add(_Atomic uint64_t *cell, uint64_t v) {
+    if (metrics_tls_exclusive) {
+        uint64_t cur = atomic_load_explicit(cell, memory_order_relaxed);
+        atomic_store_explicit(cell, cur + v, memory_order_relaxed);
+    } else {
+        atomic_fetch_add_explicit(cell, v, memory_order_relaxed);
+    }
+}
+
+/**
+ * Add to a counter (hot path)
+ * @param id Counter id from metrics_counter()
+ * @param v Increment
+ */
+static inline void metrics_add(MetricId id, uint64_t v) {
+    metrics_cell_add(&metrics_shard()->counters[id], v);
+}
+
+/**
+ * Increment a counter by one (hot path)
+ * @param id Counter id from metrics_counter()
+ */
+static inline void metrics_inc(MetricId id) {
+    metrics_add(id, 1);
+}
+
+/**
+ * Set a gauge (hot path; last writer wins)
+ * @param id Gauge id from metrics_gauge()
+ * @param v Value
+ */
+static inline void metrics_gauge_set(MetricId id, int64_t v) {
+    atomic_store_explicit(&metrics_gauges[id], v, memory_order_relaxed);
+}
+
+/**
+ * Record a histogram sample (hot path)
+ * @param id Histogram id from metrics_histogram()
+ * @param v Value (e.g. nanoseconds, queue depth)
+ */
+static inline void metrics_observe(MetricId id, uint64_t v) {
+    MetricsHistShard *h = &metrics_shard()->hist[id];
+    unsigned b;
+
+#if defined(__GNUC__)
+    b = (v == 0) ? 0 : 64u - (unsigned)__builtin_clzll(v);
+#else
+    b = 0;
+    for (uint64_t t = v; t != 0; t >>= 1) b++;
+#endif
+    if (b >= METRICS_HIST_BUCKETS) {
+        b = METRICS_HIST_BUCKETS - 1;
+    }
+
+    metrics_cell_add(&h->buckets[b], 1);
+    metrics_cell_add(&h->sum, v);
+}
+
+/**
+ * Register a counter (startup only, not thread-safe)
+ * @param name Prometheus metric name (string must outlive the registry)
+ * @return Counter id, METRICS_INVALID if full
+ */
+MetricId metrics_counter(const char *name);
+
+/**
+ * Register a gauge (startup only)
+ * @param name Prometheus metric name
+ * @return Gauge id, METRICS_INVALID if full
+ */
+MetricId metrics_gauge(const char *name);
+
+/**
+ * Register a log2 histogram (startup only)
+ * @param name Prometheus metric name
+ * @return Histogram id, METRICS_INVALID if full
+ */
+MetricId metrics_histogram(const char *name);
+
+/**
+ * Sum all shards into a snapshot (any thread, lock-free)
+ * @param snap Output snapshot
+ */
+void metrics_snapshot(MetricsSnapshot *snap);
+
+/**
+ * Format a snapshot in Prometheus text exposition format
+ * @param snap Snapshot
+ * @param buf Output buffer
+ * @param cap Buffer size
+ * @return Bytes written (excluding NUL), truncated at cap - 1
+ */
+size_t metrics_format_prometheus(const MetricsSnapshot *snap, char *buf, size_t cap);
+
+/**
+ * Monotonic clock for latency histograms
+ * @return Nanoseconds since an arbitrary origin
+ */
+uint64_t metrics_now_ns(void);
+
+/**
+ * Serve GET /metrics on 127.0.0.1:port from a background thread
+ * @param port TCP port
+ * @return true if the listener started
+ */
+bool metrics_http_start(uint16_t port);
+
+/**
+ * Stop the HTTP endpoint and join its thread
+ */
+void metrics_http_stop(void);
+
+#endif // METRICS_H
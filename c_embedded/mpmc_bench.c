@@ -0,0 +1,288 @@
+/**
+ * MPMC Queue Benchmark
+ *
+ * Several acquisition threads hand sample blocks (by pool index) to a
+ * pool of worker threads. Compares the lock-free MPMC queue, single and
+ * batched, against a mutex-protected ring with the same capacity.
+ *
+ * Each producer owns a disjoint slice of the block pool: it fills a free
+ * block, queues its index, and the consumer reads every sample, checks
+ * them and hands the block back. Every run checks that each value was
+ * delivered exactly once and intact (atomic seen-bitmap plus per-sample
+ * check, identical overhead for all three queues).
+ *
+ * Compile: gcc -O2 -o mpmc_bench mpmc_bench.c mpmc_queue.c -lm -pthread
+ * Run: ./mpmc_bench [blocks_per_producer]
+ */
+
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sched.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include "mpmc_queue.h"
+
+#define BENCH_MAX_THREADS 8
+#define BENCH_BLOCK_LEN 64
+#define BENCH_POOL_BLOCKS 4096      // Split evenly between producers
+#define BENCH_BATCH 16
+
+typedef enum {
+    QUEUE_MPMC = 0,
+    QUEUE_MPMC_BATCH,
+    QUEUE_MUTEX
+} QueueKind;
+
+// Mutex baseline: same ring, one lock around head/tail
+typedef struct {
+    pthread_mutex_t lock;
+    uint32_t values[MPMC_CAPACITY];
+    uint32_t head;
+    uint32_t tail;
+} MutexQueue;
+
+typedef struct {
+    atomic_bool busy;               // Set by the owning producer, cleared by the consumer
+    uint32_t value;                 // Producer + sequence, for the exactly-once check
+    float data[BENCH_BLOCK_LEN];
+} BenchBlock;
+
+static MpmcQueue mpmc;
+static MutexQueue mutexq;
+static BenchBlock pool[BENCH_POOL_BLOCKS];
+
+static QueueKind kind;
+static int num_producers;
+static int num_consumers;
+static uint32_t per_producer;
+static atomic_uint producers_done;
+static _Atomic uint64_t consumed_count;
+static _Atomic uint64_t *seen;         // One bit per value
+static _Atomic uint64_t duplicates;
+static _Atomic uint64_t corrupted;
+
+static bool mutex_push(MutexQueue *q, uint32_t v) {
+    bool ok = false;
+    pthread_mutex_lock(&q->lock);
+    if (q->head - q->tail < MPMC_CAPACITY) {
+        q->values[q->head++ & (MPMC_CAPACITY - 1)] = v;
+        ok = true;
+    }
+    pthread_mutex_unlock(&q->lock);
+    return ok;
+}
+
+static bool mutex_empty(MutexQueue *q) {
+    pthread_mutex_lock(&q->lock);
+    bool empty = (q->head == q->tail);
+    pthread_mutex_unlock(&q->lock);
+    return empty;
+}
+
+static bool mutex_pop(MutexQueue *q, uint32_t *v) {
+    bool ok = false;
+    pthread_mutex_lock(&q->lock);
+    if (q->head != q->tail) {
+        *v = q->values[q->tail++ & (MPMC_CAPACITY - 1)];
+        ok = true;
+    }
+    pthread_mutex_unlock(&q->lock);
+    return ok;
+}
+
+// Encode producer + sequence so the consumer side can check delivery
+static uint32_t make_value(int producer, uint32_t seq) {
+    return (uint32_t)producer * per_producer + seq;
+}
+
+static float sample_of(uint32_t v, uint32_t i) {
+    return (float)((v + i) & 0xFFFF);
+}
+
+// "Acquire" one block into the producer's own slice; the queue publishes it
+static uint32_t fill_block(int id, uint32_t seq) {
+    uint32_t slice = BENCH_POOL_BLOCKS / (uint32_t)num_producers;
+    uint32_t b = (uint32_t)id * slice + seq % slice;
+    BenchBlock *blk = &pool[b];
+
+    while (atomic_load_explicit(&blk->busy, memory_order_acquire)) {
+        sched_yield();  // Still being read: the slice is a full lap ahead
+    }
+    atomic_store_explicit(&blk->busy, true, memory_order_relaxed);
+    blk->value = make_value(id, seq);
+    for (uint32_t i = 0; i < BENCH_BLOCK_LEN; i++) {
+        blk->data[i] = sample_of(blk->value, i);
+    }
+    return b;
+}
+
+// Read and check every sample, then hand the block back to its producer
+static uint32_t consume_block(uint32_t b) {
+    BenchBlock *blk = &pool[b];
+    uint32_t v = blk->value;
+    bool intact = true;
+
+    for (uint32_t i = 0; i < BENCH_BLOCK_LEN; i++) {
+        intact &= (blk->data[i] == sample_of(v, i));
+    }
+    if (!intact) {
+        atomic_fetch_add(&corrupted, 1);
+    }
+    atomic_store_explicit(&blk->busy, false, memory_order_release);
+    return v;
+}
+
+static void *producer_main(void *arg) {
+    int id = (int)(intptr_t)arg;
+    uint32_t batch[BENCH_BATCH];
+    uint32_t seq = 0;
+
+    while (seq < per_producer) {
+        if (kind == QUEUE_MPMC_BATCH) {
+            uint32_t n = 0;
+            while (n < BENCH_BATCH && seq + n < per_producer) {
+                batch[n] = fill_block(id, seq + n);
+                n++;
+            }
+            uint32_t sent = 0;
+            while (sent < n) {
+                uint32_t k = mpmc_enqueue_batch(&mpmc, batch + sent, n - sent);
+                if (k == 0) sched_yield();
+                sent += k;
+            }
+            seq += n;
+        } else {
+            uint32_t b = fill_block(id, seq);
+            while (!((kind == QUEUE_MPMC) ? mpmc_try_enqueue(&mpmc, b)
+                                          : mutex_push(&mutexq, b))) {
+                sched_yield();
+            }
+            seq++;
+        }
+    }
+
+    atomic_fetch_add(&producers_done, 1);
+    return NULL;
+}
+
+static void *consumer_main(void *arg) {
+    (void)arg;
+    uint32_t batch[BENCH_BATCH];
+    uint64_t count = 0;
+
+    for (;;) {
+        uint32_t n;
+        if (kind == QUEUE_MPMC_BATCH) {
+            n = mpmc_dequeue_batch(&mpmc, batch, BENCH_BATCH);
+        } else if (kind == QUEUE_MPMC) {
+            n = mpmc_try_dequeue(&mpmc, &batch[0]) ? 1 : 0;
+        } else {
+            n = mutex_pop(&mutexq, &batch[0]) ? 1 : 0;
+        }
+
+        if (n == 0) {
+            // Done only once producers finished and the queue drained
+            if (atomic_load(&producers_done) == (unsigned)num_producers) {
+                bool empty = (kind == QUEUE_MUTEX) ? mutex_empty(&mutexq)
+                                                   : (mpmc_size(&mpmc) == 0);
+                if (empty) break;
+            }
+            sched_yield();
+            continue;
+        }
+
+        for (uint32_t i = 0; i < n; i++) {
+            uint32_t v = consume_block(batch[i]);
+            uint64_t bit = 1ull << (v & 63);
+            if (atomic_fetch_or_explicit(&seen[v >> 6], bit,
+                                         memory_order_relaxed) & bit) {
+                atomic_fetch_add(&duplicates, 1);
+            }
+        }
+        count += n;
+    }
+
+    atomic_fetch_add(&consumed_count, count);
+    return NULL;
+}
+
+static double now_s(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static void run(QueueKind k, int producers, int consumers) {
+    static const char *names[] = { "mpmc", "mpmc-batch", "mutex" };
+    pthread_t threads[2 * BENCH_MAX_THREADS];
+
+    kind = k;
+    num_producers = producers;
+    num_consumers = consumers;
+    atomic_store(&producers_done, 0);
+    atomic_store(&consumed_count, 0);
+    atomic_store(&duplicates, 0);
+    atomic_store(&corrupted, 0);
+    uint64_t total = (uint64_t)producers * per_producer;
+    size_t words = (size_t)((total + 63) / 64);
+    seen = calloc(words, sizeof(*seen));
+    if (seen == NULL) {
+        fprintf(stderr, "out of memory\n");
+        exit(1);
+    }
+    mpmc_init(&mpmc);
+    mutexq.head = mutexq.tail = 0;
+    for (uint32_t b = 0; b < BENCH_POOL_BLOCKS; b++) {
+        atomic_store(&pool[b].busy, false);
+    }
+
+    double t0 = now_s();
+    for (int i = 0; i < consumers; i++) {
+        pthread_create(&threads[i], NULL, consumer_main, NULL);
+    }
+    for (int i = 0; i < producers; i++) {
+        pthread_create(&threads[consumers + i], NULL, producer_main, (void *)(intptr_t)i);
+    }
+    for (int i = 0; i < producers + consumers; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    double dt = now_s() - t0;
+
+    // Exactly once: no value seen twice, every value 0..total-1 seen, no torn block
+    bool ok = atomic_load(&consumed_count) == total && atomic_load(&duplicates) == 0 &&
+              atomic_load(&corrupted) == 0;
+    for (size_t w = 0; ok && w < words; w++) {
+        uint64_t bits = atomic_load_explicit(&seen[w], memory_order_relaxed);
+        uint64_t want = (w + 1 < words || total % 64 == 0) ? ~0ull
+                                                            : (1ull << (total % 64)) - 1;
+        ok = (bits == want);
+    }
+    free(seen);
+
+    printf("  %-11s %dP/%dC  %8.2f Mblocks/s  %s\n", names[k], producers, consumers,
+           (double)total / dt / 1e6, ok ? "ok" : "LOST/DUPLICATED/CORRUPT");
+}
+
+int main(int argc, char *argv[]) {
+    static const int configs[][2] = { {1, 1}, {2, 2}, {4, 4}, {4, 1}, {1, 4} };
+
+    per_producer = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 10) : 200000u;
+    if (per_producer == 0) {
+        fprintf(stderr, "usage: %s [blocks_per_producer]\n", argv[0]);
+        return 1;
+    }
+    pthread_mutex_init(&mutexq.lock, NULL);
+
+    printf("MPMC block-index queue benchmark (%u blocks per producer)\n", per_producer);
+    for (size_t c = 0; c < sizeof(configs) / sizeof(configs[0]); c++) {
+        for (int k = QUEUE_MPMC; k <= QUEUE_MUTEX; k++) {
+            run((QueueKind)k, configs[c][0], configs[c][1]);
+        }
+    }
+
+    pthread_mutex_destroy(&mutexq.lock);
+    return 0;
+}
@@ -0,0 +1,157 @@
+/**
+ * Bounded MPMC Queue Implementation
+ */
+
+#include "mpmc_queue.h"
+
+#define MPMC_MASK (MPMC_CAPACITY - 1)
+
+// Positions wrap at 2^32; compare through a signed difference
+static inline int32_t pos_diff(uint32_t a, uint32_t b) {
+    return (int32_t)(a - b);
+}
+
+void mpmc_init(MpmcQueue *q) {
+    for (uint32_t i = 0; i < MPMC_CAPACITY; i++) {
+        atomic_init(&q->cells[i].seq, i);
+        q->cells[i].value = 0;
+    }
+    atomic_init(&q->enqueue_pos, 0);
+    atomic_init(&q->dequeue_pos, 0);
+}
+
+bool mpmc_try_enqueue(MpmcQueue *q, uint32_t value) {
+    uint32_t pos = atomic_load_explicit(&q->enqueue_pos, memory_order_relaxed);
+
+    for (;;) {
+        MpmcCell *cell = &q->cells[pos & MPMC_MASK];
+        uint32_t seq = atomic_load_explicit(&cell->seq, memory_order_acquire);
+        int32_t dif = pos_diff(seq, pos);
+
+        if (dif == 0) {
+            if (atomic_compare_exchange_weak_explicit(&q->enqueue_pos, &pos, pos + 1,
+                                                      memory_order_relaxed,
+                                                      memory_order_relaxed)) {
+                cell->value = value;
+                atomic_store_explicit(&cell->seq, pos + 1, memory_order_release);
+                return true;
+            }
+            // CAS failure reloaded pos
+        } else if (dif < 0) {
+            return false;  // Slot still holds last lap's value: full
+        } else {
+            pos = atomic_load_explicit(&q->enqueue_pos, memory_order_relaxed);
+        }
+    }
+}
+
+bool mpmc_try_dequeue(MpmcQueue *q, uint32_t *value) {
+    uint32_t pos = atomic_load_explicit(&q->dequeue_pos, memory_order_relaxed);
+
+    for (;;) {
+        MpmcCell *cell = &q->cells[pos & MPMC_MASK];
+        uint32_t seq = atomic_load_explicit(&cell->seq, memory_order_acquire);
+        int32_t dif = pos_diff(seq, pos + 1);
+
+        if (dif == 0) {
+            if (atomic_compare_exchange_weak_explicit(&q->dequeue_pos, &pos, pos + 1,
+                                                      memory_order_relaxed,
+                                                      memory_order_relaxed)) {
+                *value = cell->value;
+                atomic_store_explicit(&cell->seq, pos + MPMC_CAPACITY, memory_order_release);
+                return true;
+            }
+        } else if (dif < 0) {
+            return false;  // Not yet published: empty
+        } else {
+            pos = atomic_load_explicit(&q->dequeue_pos, memory_order_relaxed);
+        }
+    }
+}
+
+uint32_t mpmc_enqueue_batch(MpmcQueue *q, const uint32_t *values, uint32_t n) {
+    uint32_t pos = atomic_load_explicit(&q->enqueue_pos, memory_order_relaxed);
+    uint32_t k;
+
+    for (;;) {
+        // Count consecutive free slots; only those are claimed
+        k = 0;
+        while (k < n && k < MPMC_CAPACITY &&
+               atomic_load_explicit(&q->cells[(pos + k) & MPMC_MASK].seq,
+                                    memory_order_acquire) == pos + k) {
+            k++;
+        }
+
+        if (k == 0) {
+            uint32_t seq = atomic_load_explicit(&q->cells[pos & MPMC_MASK].seq,
+                                                memory_order_acquire);
+            if (pos_diff(seq, pos) < 0) {
+                return 0;  // Full
+            }
+            pos = atomic_load_explicit(&q->enqueue_pos, memory_order_relaxed);
+            continue;
+        }
+
+        if (atomic_compare_exchange_weak_explicit(&q->enqueue_pos, &pos, pos + k,
+                                                  memory_order_relaxed,
+                                                  memory_order_relaxed)) {
+            break;
+        }
+    }
+
+    // Slots were free when counted and are ours now: fill and publish in order
+    for (uint32_t i = 0; i < k; i++) {
+        MpmcCell *cell = &q->cells[(pos + i) & MPMC_MASK];
+        cell->value = values[i];
+        atomic_store_explicit(&cell->seq, pos + i + 1, memory_order_release);
+    }
+    return k;
+}
+
+uint32_t mpmc_dequeue_batch(MpmcQueue *q, uint32_t *values, uint32_t n) {
+    uint32_t pos = atomic_load_explicit(&q->dequeue_pos, memory_order_relaxed);
+    uint32_t k;
+
+    for (;;) {
+        // Count consecutive published slots; a producer still writing ends the run
+        k = 0;
+        while (k < n && k < MPMC_CAPACITY &&
+               atomic_load_explicit(&q->cells[(pos + k) & MPMC_MASK].seq,
+                                    memory_order_acquire) == pos + k + 1) {
+            k++;
+        }
+
+        if (k == 0) {
+            uint32_t seq = atomic_load_explicit(&q->cells[pos & MPMC_MASK].seq,
+                                                memory_order_acquire);
+            if (pos_diff(seq, pos + 1) < 0) {
+                return 0;  // Empty
+            }
+            pos = atomic_load_explicit(&q->dequeue_pos, memory_order_relaxed);
+            continue;
+        }
+
+        if (atomic_compare_exchange_weak_explicit(&q->dequeue_pos, &pos, pos + k,
+                                                  memory_order_relaxed,
+                                                  memory_order_relaxed)) {
+            break;
+        }
+    }
+
+    for (uint32_t i = 0; i < k; i++) {
+        MpmcCell *cell = &q->cells[(pos + i) & MPMC_MASK];
+        values[i] = cell->value;
+        atomic_store_explicit(&cell->seq, pos + i + MPMC_CAPACITY, memory_order_release);
+    }
+    return k;
+}
+
+uint32_t mpmc_size(MpmcQueue *q) {
+    uint32_t deq = atomic_load_explicit(&q->dequeue_pos, memory_order_acquire);
+    uint32_t enq = atomic_load_explicit(&q->enqueue_pos, memory_order_acquire);
+    int32_t d = pos_diff(enq, deq);
+
+    if (d < 0) return 0;
+    if (d > MPMC_CAPACITY) return MPMC_CAPACITY;
+    return (uint32_t)d;
+}
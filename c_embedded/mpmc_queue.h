@@ -0,0 +1,90 @@
+/**
+ * Bounded MPMC Queue of Block Indices
+ * Fan-in from several acquisition threads to a pool of workers
+ *
+ * Vyukov-style ring: every slot carries a sequence number that says whose
+ * turn it is (seq == pos: free for the producer at pos; seq == pos + 1:
+ * holds the value for the consumer at pos). Producers and consumers claim
+ * positions with one CAS on their own cache-line-aligned counter and
+ * never touch a shared lock.
+ *
+ * Values are 32-bit indices (e.g. into a block pool), so the queue moves
+ * 4 bytes per block no matter how large the sample block is.
+ *
+ * Key points:
+ * - All operations are lock-free and fail fast when full or empty
+ * - Batch calls count the run of ready slots (free for enqueue, published
+ *   for dequeue), claim the whole run with one CAS and then fill or drain
+ *   it without waiting; a preempted peer only shortens the run
+ * - Capacity is a compile-time power of 2, storage is inline (no malloc)
+ */
+
+#ifndef MPMC_QUEUE_H
+#define MPMC_QUEUE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+#define MPMC_CAPACITY 1024          // Power of 2
+#define MPMC_CACHE_LINE 64
+
+typedef struct {
+    _Atomic uint32_t seq;
+    uint32_t value;
+} MpmcCell;
+
+typedef struct {
+    _Alignas(MPMC_CACHE_LINE) _Atomic uint32_t enqueue_pos;
+    _Alignas(MPMC_CACHE_LINE) _Atomic uint32_t dequeue_pos;
+    _Alignas(MPMC_CACHE_LINE) MpmcCell cells[MPMC_CAPACITY];
+} MpmcQueue;
+
+/**
+ * Initialize an empty queue
+ * @param q Pointer to MpmcQueue
+ */
+void mpmc_init(MpmcQueue *q);
+
+/**
+ * Enqueue one value
+ * @param q Pointer to MpmcQueue
+ * @param value Value (block index)
+ * @return false if the queue is full
+ */
+bool mpmc_try_enqueue(MpmcQueue *q, uint32_t value);
+
+/**
+ * Dequeue one value
+ * @param q Pointer to MpmcQueue
+ * @param value Output value
+ * @return false if the queue is empty
+ */
+bool mpmc_try_dequeue(MpmcQueue *q, uint32_t *value);
+
+/**
+ * Enqueue up to n values with one claim
+ * @param q Pointer to MpmcQueue
+ * @param values Values in order
+ * @param n Number of values
+ * @return Number enqueued (0 if full), always a prefix of values
+ */
+uint32_t mpmc_enqueue_batch(MpmcQueue *q, const uint32_t *values, uint32_t n);
+
+/**
+ * Dequeue up to n values with one claim
+ * @param q Pointer to MpmcQueue
+ * @param values Output array
+ * @param n Capacity of values
+ * @return Number dequeued (0 if empty)
+ */
+uint32_t mpmc_dequeue_batch(MpmcQueue *q, uint32_t *values, uint32_t n);
+
+/**
+ * Approximate number of queued values (exact when quiescent)
+ * @param q Pointer to MpmcQueue
+ * @return Queue depth
+ */
+uint32_t mpmc_size(MpmcQueue *q);
+
+#endif // MPMC_QUEUE_H
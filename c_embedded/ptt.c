@@ -0,0 +1,203 @@
+/**
+ * Pulse Transit Time Implementation
+ */
+
+#include "ptt.h"
+#include <math.h>
+
+typedef enum {
+    PTT_FIND_MAX = 0,
+    PTT_FIND_MIN,
+    PTT_FIND_SLOPE
+} PttSearch;
+
+bool ptt_init(PttEngine *ptt, const PttConfig *cfg) {
+    if (cfg->sample_rate <= 0.0f || cfg->search_half == 0 ||
+        cfg->min_ptt_ms < 0.0f || cfg->max_ptt_ms <= cfg->min_ptt_ms) {
+        return false;
+    }
+
+    uint32_t ppg_back = cfg->search_half;
+    uint32_t ppg_ahead = cfg->search_half;
+    if (cfg->fiducial != PTT_PPG_PEAK) {
+        // Foot and upstroke lie before a peak-triggered event
+        if (cfg->upstroke_ms <= 0.0f) {
+            return false;
+        }
+        ppg_back = (uint32_t)ceilf(cfg->upstroke_ms * cfg->sample_rate / 1000.0f);
+        ppg_ahead = 0;
+    }
+    // Window plus slope/parabola neighbours and look-ahead must stay in history
+    if (2u * cfg->search_half + 6 >= PTT_HISTORY || ppg_back + ppg_ahead + 6 >= PTT_HISTORY) {
+        return false;
+    }
+
+    ptt->cfg = *cfg;
+    ptt->win_back[PTT_CH_ECG] = cfg->search_half;
+    ptt->win_ahead[PTT_CH_ECG] = cfg->search_half;
+    ptt->win_back[PTT_CH_PPG] = (uint16_t)ppg_back;
+    ptt->win_ahead[PTT_CH_PPG] = (uint16_t)ppg_ahead;
+    for (int c = 0; c < PTT_CHANNELS; c++) {
+        for (int i = 0; i < PTT_HISTORY; i++) {
+            ptt->hist[c][i] = 0.0f;
+        }
+        ptt->raw_head[c] = 0;
+        ptt->raw_count[c] = 0;
+    }
+    ptt->head = 0;
+    ptt->sample = 0;
+    ptt->r_head = 0;
+    ptt->r_count = 0;
+    return true;
+}
+
+static float ptt_value(const PttEngine *ptt, uint8_t ch, uint32_t idx, PttSearch kind) {
+    const float *h = ptt->hist[ch];
+    uint32_t mask = PTT_HISTORY - 1;
+
+    switch (kind) {
+    case PTT_FIND_MIN:
+        return -h[idx & mask];
+    case PTT_FIND_SLOPE:
+        return h[(idx + 1) & mask] - h[(idx - 1) & mask];  // Central difference
+    default:
+        return h[idx & mask];
+    }
+}
+
+// Extremum in the channel's window around idx, refined to a fractional
+// sample index; false if it sits on the window edge (no turning point)
+static bool ptt_refine(const PttEngine *ptt, uint8_t ch, uint32_t idx, PttSearch kind,
+                       double *t) {
+    uint32_t lo = idx - ptt->win_back[ch];
+    uint32_t hi = idx + ptt->win_ahead[ch];
+    uint32_t best = lo;
+    float best_v = ptt_value(ptt, ch, lo, kind);
+
+    for (uint32_t i = lo + 1; i <= hi; i++) {
+        float v = ptt_value(ptt, ch, i, kind);
+        if (v > best_v) {
+            best_v = v;
+            best = i;
+        }
+    }
+    if (best == lo || best == hi) {
+        return false;
+    }
+
+    float a = ptt_value(ptt, ch, best - 1, kind);
+    float c = ptt_value(ptt, ch, best + 1, kind);
+    float denom = a - 2.0f * best_v + c;
+    float offset = (denom != 0.0f) ? 0.5f * (a - c) / denom : 0.0f;
+    if (offset > 0.5f) offset = 0.5f;
+    if (offset < -0.5f) offset = -0.5f;
+
+    *t = (double)best + offset;
+    return true;
+}
+
+static void ptt_queue_raw(PttEngine *ptt, uint8_t ch, uint32_t idx) {
+    uint8_t mask = PTT_MAX_PENDING - 1;
+
+    if (ptt->raw_count[ch] == PTT_MAX_PENDING) {
+        // Drop oldest
+        ptt->raw_head[ch] = (ptt->raw_head[ch] + 1) & mask;
+        ptt->raw_count[ch]--;
+    }
+    ptt->raw[ch][(ptt->raw_head[ch] + ptt->raw_count[ch]) & mask] = idx;
+    ptt->raw_count[ch]++;
+}
+
+// Pop the oldest raw event once its look-ahead is in the buffer
+static bool ptt_ready_raw(PttEngine *ptt, uint8_t ch, uint32_t *idx) {
+    uint32_t margin = ptt->win_ahead[ch] + 2u;
+
+    if (ptt->raw_count[ch] == 0) {
+        return false;
+    }
+
+    uint32_t e = ptt->raw[ch][ptt->raw_head[ch]];
+    if (ptt->sample <= e + margin) {
+        return false;
+    }
+
+    ptt->raw_head[ch] = (ptt->raw_head[ch] + 1) & (PTT_MAX_PENDING - 1);
+    ptt->raw_count[ch]--;
+
+    if (e < ptt->win_back[ch] + 2u) {
+        return false;  // Too close to the start of the stream to search
+    }
+    *idx = e;
+    return true;
+}
+
+static bool ptt_pair(PttEngine *ptt, double ppg_time, PttResult *out) {
+    float ms_per_sample = 1000.0f / ptt->cfg.sample_rate;
+
+    while (ptt->r_count > 0) {
+        double r_time = ptt->r_pending[ptt->r_head];
+        float ptt_ms = (float)(ppg_time - r_time) * ms_per_sample;
+
+        if (ptt_ms < ptt->cfg.min_ptt_ms) {
+            return false;  // Oldest R is too recent: PPG event belongs to an earlier beat
+        }
+
+        ptt->r_head = (ptt->r_head + 1) & (PTT_MAX_PENDING - 1);
+        ptt->r_count--;
+
+        if (ptt_ms <= ptt->cfg.max_ptt_ms) {
+            out->r_time = r_time;
+            out->ppg_time = ppg_time;
+            out->ptt_ms = ptt_ms;
+            return true;
+        }
+        // Too old: its PPG beat was missed, try the next R-peak
+    }
+
+    return false;
+}
+
+bool ptt_push(PttEngine *ptt, float ecg, float ppg, bool r_peak, bool ppg_beat,
+              PttResult *out) {
+    static const PttSearch ppg_search[] = {
+        [PTT_PPG_FOOT] = PTT_FIND_MIN,
+        [PTT_PPG_MAX_SLOPE] = PTT_FIND_SLOPE,
+        [PTT_PPG_PEAK] = PTT_FIND_MAX,
+    };
+    uint32_t idx;
+    double t;
+    bool paired = false;
+
+    ptt->hist[PTT_CH_ECG][ptt->head] = ecg;
+    ptt->hist[PTT_CH_PPG][ptt->head] = ppg;
+    ptt->head = (ptt->head + 1) & (PTT_HISTORY - 1);
+
+    if (r_peak) {
+        ptt_queue_raw(ptt, PTT_CH_ECG, ptt->sample);
+    }
+    if (ppg_beat) {
+        ptt_queue_raw(ptt, PTT_CH_PPG, ptt->sample);
+    }
+    ptt->sample++;
+
+    // R-peaks first so a PPG event refined on the same sample can pair
+    while (ptt_ready_raw(ptt, PTT_CH_ECG, &idx)) {
+        if (!ptt_refine(ptt, PTT_CH_ECG, idx, PTT_FIND_MAX, &t)) {
+            continue;
+        }
+        if (ptt->r_count == PTT_MAX_PENDING) {
+            ptt->r_head = (ptt->r_head + 1) & (PTT_MAX_PENDING - 1);
+            ptt->r_count--;
+        }
+        ptt->r_pending[(ptt->r_head + ptt->r_count) & (PTT_MAX_PENDING - 1)] = t;
+        ptt->r_count++;
+    }
+
+    while (ptt_ready_raw(ptt, PTT_CH_PPG, &idx)) {
+        if (ptt_refine(ptt, PTT_CH_PPG, idx, ppg_search[ptt->cfg.fiducial], &t)) {
+            paired |= ptt_pair(ptt, t, out);
+        }
+    }
+
+    return paired;
+}
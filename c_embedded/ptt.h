@@ -0,0 +1,105 @@
+/**
+ * Pulse Transit Time (ECG -> PPG)
+ * Per-beat PTT from time-aligned ECG and PPG channels
+ *
+ * Both channels are written into one time-aligned history (shared sample
+ * counter and head), so an event on either channel can be located on the
+ * other without any timestamp bookkeeping. Each event from the upstream
+ * detectors is refined to sub-sample precision by a local extremum search
+ * and parabolic interpolation, then R-peaks are paired with the next PPG
+ * fiducial inside the plausible PTT range.
+ *
+ * Search windows:
+ * - R-peak and PPG peak: +/- search_half around the detector event
+ * - PPG foot / max slope: from upstroke_ms before the event up to the
+ *   event, since PPG detectors typically fire at or near the systolic
+ *   peak, 100-250 ms after the foot
+ * An extremum on the edge of its window is not a real turning point; such
+ * events are dropped instead of interpolated.
+ *
+ * State is a handful of pending events per channel: O(1) per beat.
+ */
+
+#ifndef PTT_H
+#define PTT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define PTT_HISTORY     512     // Samples per channel, power of 2; holds the upstroke window
+#define PTT_MAX_PENDING 4       // Unrefined / unpaired events per channel, power of 2
+
+#define PTT_CH_ECG 0
+#define PTT_CH_PPG 1
+#define PTT_CHANNELS 2
+
+typedef enum {
+    PTT_PPG_FOOT = 0,       // Minimum before the upstroke
+    PTT_PPG_MAX_SLOPE,      // Steepest point of the upstroke (most robust)
+    PTT_PPG_PEAK            // Systolic peak
+} PttFiducial;
+
+typedef struct {
+    float sample_rate;      // Hz, shared by both channels
+    PttFiducial fiducial;
+    float min_ptt_ms;       // Plausible range, pairs outside are dropped
+    float max_ptt_ms;
+    uint8_t search_half;    // Extremum search +/- samples around an event
+    float upstroke_ms;      // FOOT / MAX_SLOPE: search this far back from the PPG event
+} PttConfig;
+
+typedef struct {
+    double r_time;          // Refined R-peak position (fractional sample index)
+    double ppg_time;        // Refined PPG fiducial position
+    float ptt_ms;
+} PttResult;
+
+typedef struct {
+    PttConfig cfg;
+
+    // Search window per channel, samples before / after an event
+    uint16_t win_back[PTT_CHANNELS];
+    uint16_t win_ahead[PTT_CHANNELS];
+
+    // Time-aligned multi-channel history
+    float hist[PTT_CHANNELS][PTT_HISTORY];
+    uint16_t head;
+    uint32_t sample;        // Index of the next sample
+
+    // Events waiting for enough look-ahead to be refined
+    uint32_t raw[PTT_CHANNELS][PTT_MAX_PENDING];
+    uint8_t raw_head[PTT_CHANNELS];
+    uint8_t raw_count[PTT_CHANNELS];
+
+    // Refined R-peaks waiting for their PPG fiducial
+    double r_pending[PTT_MAX_PENDING];
+    uint8_t r_head;
+    uint8_t r_count;
+} PttEngine;
+
+/**
+ * Initialize the engine
+ * @param ptt Pointer to PttEngine
+ * @param cfg Configuration (copied)
+ * @return true if configuration is valid and the search windows fit PTT_HISTORY
+ */
+bool ptt_init(PttEngine *ptt, const PttConfig *cfg);
+
+/**
+ * Push one time-aligned ECG/PPG sample pair
+ * @param ptt Pointer to PttEngine
+ * @param ecg ECG sample
+ * @param ppg PPG sample
+ * @param r_peak true if the ECG detector fired on this sample
+ * @param ppg_beat true if the PPG detector fired on this sample. For
+ *                 PTT_PPG_PEAK it must mark the systolic peak (within
+ *                 search_half); for FOOT / MAX_SLOPE any point from the top
+ *                 of the upstroke to the systolic peak, at most upstroke_ms
+ *                 after the foot (e.g. a peak detector)
+ * @param out Result, written when a beat is paired
+ * @return true if a PTT result was written
+ */
+bool ptt_push(PttEngine *ptt, float ecg, float ppg, bool r_peak, bool ppg_beat,
+              PttResult *out);
+
+#endif // PTT_H
@@ -0,0 +1,344 @@
+/**
+ * Record / Replay Harness Implementation
+ */
+
+#define _POSIX_C_SOURCE 200809L
+#include "record_replay.h"
+#include <math.h>
+#include <string.h>
+#include <time.h>
+
+#define REC_MAGIC "RRPL"
+#define REC_VERSION 1
+
+uint64_t rec_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static bool write_header(FILE *fp, const RecHeader *h) {
+    return fwrite(REC_MAGIC, 1, 4, fp) == 4 &&
+           fwrite(&h->version, sizeof(h->version), 1, fp) == 1 &&
+           fwrite(&h->encoding, sizeof(h->encoding), 1, fp) == 1 &&
+           fwrite(&h->sample_rate, sizeof(h->sample_rate), 1, fp) == 1 &&
+           fwrite(&h->scale, sizeof(h->scale), 1, fp) == 1 &&
+           fwrite(&h->blocks, sizeof(h->blocks), 1, fp) == 1 &&
+           fwrite(&h->samples, sizeof(h->samples), 1, fp) == 1;
+}
+
+static bool read_header(FILE *fp, RecHeader *h) {
+    char magic[4];
+
+    return fread(magic, 1, 4, fp) == 4 && memcmp(magic, REC_MAGIC, 4) == 0 &&
+           fread(&h->version, sizeof(h->version), 1, fp) == 1 &&
+           fread(&h->encoding, sizeof(h->encoding), 1, fp) == 1 &&
+           fread(&h->sample_rate, sizeof(h->sample_rate), 1, fp) == 1 &&
+           fread(&h->scale, sizeof(h->scale), 1, fp) == 1 &&
+           fread(&h->blocks, sizeof(h->blocks), 1, fp) == 1 &&
+           fread(&h->samples, sizeof(h->samples), 1, fp) == 1;
+}
+
+// LEB128: 7 bits per byte, high bit = more
+static bool write_varint(FILE *fp, uint64_t v) {
+    do {
+        uint8_t byte = (uint8_t)(v & 0x7F);
+        v >>= 7;
+        if (v != 0) {
+            byte |= 0x80;
+        }
+        if (fputc(byte, fp) == EOF) {
+            return false;
+        }
+    } while (v != 0);
+    return true;
+}
+
+static bool read_varint(FILE *fp, uint64_t *v) {
+    uint64_t result = 0;
+
+    for (int shift = 0; shift < 64; shift += 7) {
+        int c = fgetc(fp);
+        if (c == EOF) {
+            return false;
+        }
+        result |= (uint64_t)(c & 0x7F) << shift;
+        if ((c & 0x80) == 0) {
+            *v = result;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool rec_open(RecWriter *w, const char *path, float sample_rate,
+              RecEncoding encoding, float scale) {
+    if (encoding == REC_ENC_I16 && scale <= 0.0f) {
+        return false;
+    }
+
+    w->fp = fopen(path, "wb");
+    if (w->fp == NULL) {
+        return false;
+    }
+
+    w->hdr.version = REC_VERSION;
+    w->hdr.encoding = (uint16_t)encoding;
+    w->hdr.sample_rate = sample_rate;
+    w->hdr.scale = (encoding == REC_ENC_I16) ? scale : 1.0f;
+    w->hdr.blocks = 0;
+    w->hdr.samples = 0;
+    w->last_ns = 0;
+
+    // Placeholder counts, rewritten by rec_close
+    return write_header(w->fp, &w->hdr);
+}
+
+bool rec_write_block(RecWriter *w, uint64_t time_ns, const float *x, uint16_t n) {
+    if (n == 0 || n > REC_MAX_BLOCK) {
+        return false;
+    }
+
+    uint64_t dt = (w->hdr.blocks == 0) ? 0 : time_ns - w->last_ns;
+    w->last_ns = time_ns;
+
+    if (!write_varint(w->fp, dt) || !write_varint(w->fp, n)) {
+        return false;
+    }
+
+    if (w->hdr.encoding == REC_ENC_I16) {
+        int16_t q[REC_MAX_BLOCK];
+        float inv = 1.0f / w->hdr.scale;
+
+        for (uint16_t i = 0; i < n; i++) {
+            float v = roundf(x[i] * inv);
+            if (v > 32767.0f) v = 32767.0f;
+            if (v < -32768.0f) v = -32768.0f;
+            q[i] = (int16_t)v;
+        }
+        if (fwrite(q, sizeof(int16_t), n, w->fp) != n) {
+            return false;
+        }
+    } else if (fwrite(x, sizeof(float), n, w->fp) != n) {
+        return false;
+    }
+
+    w->hdr.blocks++;
+    w->hdr.samples += n;
+    return true;
+}
+
+bool rec_close(RecWriter *w) {
+    bool ok = fseek(w->fp, 0, SEEK_SET) == 0 && write_header(w->fp, &w->hdr);
+    ok = (fclose(w->fp) == 0) && ok;
+    w->fp = NULL;
+    return ok;
+}
+
+bool replay_open(RecReader *r, const char *path) {
+    r->fp = fopen(path, "rb");
+    if (r->fp == NULL) {
+        return false;
+    }
+
+    if (!read_header(r->fp, &r->hdr) || r->hdr.version != REC_VERSION ||
+        r->hdr.encoding > REC_ENC_I16) {
+        fclose(r->fp);
+        r->fp = NULL;
+        return false;
+    }
+
+    r->time_ns = 0;
+    r->blocks_read = 0;
+    return true;
+}
+
+bool replay_next(RecReader *r, uint64_t *time_ns, float *x, uint16_t *n) {
+    uint64_t dt, count;
+
+    if (r->blocks_read >= r->hdr.blocks ||
+        !read_varint(r->fp, &dt) || !read_varint(r->fp, &count) ||
+        count == 0 || count > REC_MAX_BLOCK) {
+        return false;
+    }
+
+    if (r->hdr.encoding == REC_ENC_I16) {
+        int16_t q[REC_MAX_BLOCK];
+        if (fread(q, sizeof(int16_t), (size_t)count, r->fp) != count) {
+            return false;
+        }
+        for (uint64_t i = 0; i < count; i++) {
+            x[i] = q[i] * r->hdr.scale;
+        }
+    } else if (fread(x, sizeof(float), (size_t)count, r->fp) != count) {
+        return false;
+    }
+
+    r->time_ns += dt;
+    r->blocks_read++;
+    *time_ns = r->time_ns;
+    *n = (uint16_t)count;
+    return true;
+}
+
+void replay_close(RecReader *r) {
+    if (r->fp != NULL) {
+        fclose(r->fp);
+        r->fp = NULL;
+    }
+}
+
+static uint8_t lat_bucket(uint64_t ns) {
+    uint8_t b = 0;
+
+    while (ns != 0 && b < REC_LAT_BUCKETS - 1) {
+        ns >>= 1;
+        b++;
+    }
+    return b;  // Bucket b holds [2^(b-1), 2^b)
+}
+
+static uint64_t lat_percentile(const ReplayStats *s, double p) {
+    uint64_t target = (uint64_t)ceil(p * s->blocks);
+    uint64_t seen = 0;
+
+    for (int b = 0; b < REC_LAT_BUCKETS; b++) {
+        seen += s->lat_hist[b];
+        if (seen >= target && seen > 0) {
+            uint64_t upper = (b == 0) ? 0 : (1ull << b) - 1;
+            return upper < s->lat_max_ns ? upper : s->lat_max_ns;
+        }
+    }
+    return s->lat_max_ns;
+}
+
+static void sleep_until(uint64_t target_ns) {
+    uint64_t now = rec_now_ns();
+
+    if (target_ns > now) {
+        uint64_t d = target_ns - now;
+        struct timespec ts = { (time_t)(d / 1000000000ull), (long)(d % 1000000000ull) };
+        nanosleep(&ts, NULL);
+    }
+}
+
+bool replay_run(const char *path, ReplayPace pace, ReplayProcessFn fn, void *user,
+                const char *golden_path, GoldenMode golden, float tolerance,
+                ReplayStats *stats) {
+    RecReader r;
+    FILE *gfp = NULL;
+    float in[REC_MAX_BLOCK], out[REC_MAX_BLOCK], ref[REC_MAX_BLOCK];
+
+    memset(stats, 0, sizeof(*stats));
+    stats->lat_min_ns = UINT64_MAX;
+    stats->golden_ok = true;
+
+    if (!replay_open(&r, path)) {
+        return false;
+    }
+    if (golden != GOLDEN_NONE) {
+        gfp = fopen(golden_path, golden == GOLDEN_WRITE ? "wb" : "rb");
+        if (gfp == NULL) {
+            replay_close(&r);
+            return false;
+        }
+    }
+
+    uint64_t lat_sum = 0;
+    uint64_t t_rec;
+    uint16_t n;
+    uint64_t start = rec_now_ns();
+
+    while (replay_next(&r, &t_rec, in, &n)) {
+        uint64_t t0;
+
+        if (pace == REPLAY_REALTIME) {
+            // Latency counts from the scheduled arrival, so lag shows up
+            t0 = start + t_rec;
+            sleep_until(t0);
+        } else {
+            t0 = rec_now_ns();
+        }
+
+        fn(user, in, out, n);
+        uint64_t t1 = rec_now_ns();
+
+        uint64_t lat = t1 > t0 ? t1 - t0 : 0;
+        lat_sum += lat;
+        if (lat < stats->lat_min_ns) stats->lat_min_ns = lat;
+        if (lat > stats->lat_max_ns) stats->lat_max_ns = lat;
+        stats->lat_hist[lat_bucket(lat)]++;
+
+        if (golden == GOLDEN_WRITE) {
+            if (fwrite(out, sizeof(float), n, gfp) != n) {
+                stats->golden_ok = false;
+            }
+        } else if (golden == GOLDEN_CHECK) {
+            size_t got = fread(ref, sizeof(float), n, gfp);
+            for (uint16_t i = 0; i < n; i++) {
+                float err = (i < got) ? fabsf(out[i] - ref[i]) : INFINITY;
+                if (!(err <= tolerance)) {
+                    if (stats->golden_mismatches == 0) {
+                        stats->golden_first_mismatch = stats->samples + i;
+                    }
+                    stats->golden_mismatches++;
+                }
+                if (i < got && err > stats->golden_max_error) {
+                    stats->golden_max_error = err;
+                }
+            }
+        }
+
+        stats->blocks++;
+        stats->samples += n;
+    }
+
+    uint64_t end = rec_now_ns();
+    bool complete = r.blocks_read == r.hdr.blocks;
+    replay_close(&r);
+
+    if (gfp != NULL) {
+        // Leftover reference data means the output got shorter
+        if (golden == GOLDEN_CHECK && fgetc(gfp) != EOF) {
+            stats->golden_ok = false;
+        }
+        if (fclose(gfp) != 0) {
+            stats->golden_ok = false;
+        }
+    }
+    if (stats->golden_mismatches > 0) {
+        stats->golden_ok = false;
+    }
+
+    stats->wall_seconds = (double)(end - start) * 1e-9;
+    stats->samples_per_sec = stats->wall_seconds > 0.0
+                             ? (double)stats->samples / stats->wall_seconds : 0.0;
+    if (stats->blocks > 0) {
+        stats->lat_mean_ns = (double)lat_sum / stats->blocks;
+        stats->lat_p50_ns = lat_percentile(stats, 0.50);
+        stats->lat_p99_ns = lat_percentile(stats, 0.99);
+    } else {
+        stats->lat_min_ns = 0;
+    }
+
+    return complete && stats->golden_ok;
+}
+
+void replay_print_stats(FILE *out, const ReplayStats *stats) {
+    fprintf(out, "blocks=%u samples=%llu\n", stats->blocks,
+            (unsigned long long)stats->samples);
+    fprintf(out, "wall_s=%.6f throughput_sps=%.0f\n", stats->wall_seconds,
+            stats->samples_per_sec);
+    fprintf(out, "latency_ns min=%llu mean=%.0f p50<=%llu p99<=%llu max=%llu\n",
+            (unsigned long long)stats->lat_min_ns, stats->lat_mean_ns,
+            (unsigned long long)stats->lat_p50_ns,
+            (unsigned long long)stats->lat_p99_ns,
+            (unsigned long long)stats->lat_max_ns);
+    fprintf(out, "golden=%s mismatches=%llu max_err=%g",
+            stats->golden_ok ? "ok" : "FAIL",
+            (unsigned long long)stats->golden_mismatches, stats->golden_max_error);
+    if (stats->golden_mismatches > 0) {
+        fprintf(out, " first=%llu", (unsigned long long)stats->golden_first_mismatch);
+    }
+    fprintf(out, "\n");
+}
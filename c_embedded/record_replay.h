@@ -0,0 +1,176 @@
+/**
+ * Record / Replay Harness
+ * Deterministic input capture and replay for performance regression runs
+ *
+ * Capture file (host byte order, little-endian in practice):
+ *   header : "RRPL", version, encoding, sample_rate, scale, blocks, samples
+ *   block  : varint dt_ns (since previous block), varint n, n samples
+ * Samples are float32 or int16 (value = i16 * scale, half the size).
+ * Delta-varint timing costs 2-4 bytes per block instead of 8.
+ *
+ * Replay drives any block-processing function at maximum speed or at the
+ * recorded pace, optionally writes or checks a golden output file, and
+ * reports throughput plus per-block latency (min / mean / p50 / p99 /
+ * max from a log2 histogram) so two builds can be compared on exactly
+ * the same input.
+ */
+
+#ifndef RECORD_REPLAY_H
+#define RECORD_REPLAY_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+#define REC_MAX_BLOCK 1024          // Samples per recorded block
+#define REC_LAT_BUCKETS 40          // log2(ns) histogram buckets
+
+typedef enum {
+    REC_ENC_F32 = 0,
+    REC_ENC_I16 = 1
+} RecEncoding;
+
+typedef enum {
+    REPLAY_MAX_SPEED = 0,           // Back-to-back, measures processing cost
+    REPLAY_REALTIME                 // Honors recorded inter-block timing
+} ReplayPace;
+
+typedef enum {
+    GOLDEN_NONE = 0,
+    GOLDEN_WRITE,                   // Store outputs as the new reference
+    GOLDEN_CHECK                    // Compare outputs to the reference
+} GoldenMode;
+
+typedef struct {
+    uint16_t version;
+    uint16_t encoding;              // RecEncoding
+    float sample_rate;
+    float scale;                    // int16 LSB value (REC_ENC_I16)
+    uint32_t blocks;
+    uint64_t samples;
+} RecHeader;
+
+typedef struct {
+    FILE *fp;
+    RecHeader hdr;
+    uint64_t last_ns;
+} RecWriter;
+
+typedef struct {
+    FILE *fp;
+    RecHeader hdr;
+    uint64_t time_ns;               // Timestamp of the last block read
+    uint32_t blocks_read;
+} RecReader;
+
+/**
+ * Process one block; out has room for n samples
+ * @param user Caller context
+ * @param in Input samples
+ * @param out Output samples (compared against the golden file)
+ * @param n Number of samples
+ */
+typedef void (*ReplayProcessFn)(void *user, const float *in, float *out, uint16_t n);
+
+typedef struct {
+    uint32_t blocks;
+    uint64_t samples;
+    double wall_seconds;
+    double samples_per_sec;
+
+    uint64_t lat_min_ns;
+    uint64_t lat_max_ns;
+    double lat_mean_ns;
+    uint64_t lat_p50_ns;            // Bucket upper bounds (within 2x)
+    uint64_t lat_p99_ns;
+    uint32_t lat_hist[REC_LAT_BUCKETS];
+
+    uint64_t golden_mismatches;     // Samples outside tolerance
+    uint64_t golden_first_mismatch; // Sample index, valid if mismatches > 0
+    float golden_max_error;
+    bool golden_ok;
+} ReplayStats;
+
+/**
+ * Create a capture file
+ * @param w Pointer to RecWriter
+ * @param path File path
+ * @param sample_rate Sample rate in Hz
+ * @param encoding Sample encoding
+ * @param scale int16 LSB value (ignored for float32)
+ * @return true on success
+ */
+bool rec_open(RecWriter *w, const char *path, float sample_rate,
+              RecEncoding encoding, float scale);
+
+/**
+ * Append a block
+ * @param w Pointer to RecWriter
+ * @param time_ns Arrival time of the block (monotonic, any origin)
+ * @param x Samples
+ * @param n Number of samples (<= REC_MAX_BLOCK)
+ * @return true on success
+ */
+bool rec_write_block(RecWriter *w, uint64_t time_ns, const float *x, uint16_t n);
+
+/**
+ * Finalize the header and close
+ * @param w Pointer to RecWriter
+ * @return true on success
+ */
+bool rec_close(RecWriter *w);
+
+/**
+ * Open a capture file for reading
+ * @param r Pointer to RecReader
+ * @param path File path
+ * @return true if the header is valid
+ */
+bool replay_open(RecReader *r, const char *path);
+
+/**
+ * Read the next block
+ * @param r Pointer to RecReader
+ * @param time_ns Block timestamp relative to the first block
+ * @param x Destination (REC_MAX_BLOCK samples)
+ * @param n Samples read
+ * @return false at end of file or on a corrupt block
+ */
+bool replay_next(RecReader *r, uint64_t *time_ns, float *x, uint16_t *n);
+
+/**
+ * Close a reader
+ * @param r Pointer to RecReader
+ */
+void replay_close(RecReader *r);
+
+/**
+ * Replay a capture through a processing function
+ * @param path Capture file
+ * @param pace Maximum speed or real-time
+ * @param fn Block processing function
+ * @param user Passed to fn
+ * @param golden_path Golden output file (NULL with GOLDEN_NONE)
+ * @param golden Golden mode
+ * @param tolerance Max absolute error accepted by GOLDEN_CHECK
+ * @param stats Output statistics
+ * @return true if the capture replayed and the golden check (if any) passed
+ */
+bool replay_run(const char *path, ReplayPace pace, ReplayProcessFn fn, void *user,
+                const char *golden_path, GoldenMode golden, float tolerance,
+                ReplayStats *stats);
+
+/**
+ * Print statistics in a stable, diff-friendly format
+ * @param out Output stream
+ * @param stats Statistics from replay_run
+ */
+void replay_print_stats(FILE *out, const ReplayStats *stats);
+
+/**
+ * Monotonic clock helper
+ * @return Nanoseconds since an arbitrary origin
+ */
+uint64_t rec_now_ns(void);
+
+#endif // RECORD_REPLAY_H
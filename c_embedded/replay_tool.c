@@ -0,0 +1,96 @@
+/**
+ * Replay Tool - Performance Regression Runner
+ *
+ * Replays a capture (e.g. from `./demo --record capture.rrpl`) through
+ * the demo's acquisition pipeline (circular buffer + moving average) and
+ * prints throughput/latency stats. With a golden file, the outputs are
+ * either stored as the new reference or checked against it, so two
+ * builds can be compared on identical input.
+ *
+ * Compile: gcc -O2 -o replay_tool replay_tool.c record_replay.c \
+ *          circular_buffer.c moving_average.c dsp_dispatch.c -lm
+ * Run: ./replay_tool capture.rrpl [--realtime] [--repeat N]
+ *                   [--write-golden out.gold | --golden out.gold [--tol X]]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "record_replay.h"
+#include "circular_buffer.h"
+#include "moving_average.h"
+
+typedef struct {
+    CircularBuffer buffer;
+    MovingAverage filter;
+} DemoPipeline;
+
+// Same per-sample work as the main.c acquisition loop
+static void demo_process(void *user, const float *in, float *out, uint16_t n) {
+    DemoPipeline *p = (DemoPipeline *)user;
+
+    for (uint16_t i = 0; i < n; i++) {
+        cb_push(&p->buffer, in[i]);
+        int32_t filtered = ma_filter(&p->filter, (int32_t)(in[i] * 1000));
+        out[i] = filtered / 1000.0f;
+    }
+}
+
+int main(int argc, char *argv[]) {
+    const char *capture = NULL;
+    const char *golden_path = NULL;
+    GoldenMode golden = GOLDEN_NONE;
+    ReplayPace pace = REPLAY_MAX_SPEED;
+    float tolerance = 0.0f;
+    int repeat = 1;
+
+    for (int a = 1; a < argc; a++) {
+        if (strcmp(argv[a], "--realtime") == 0) {
+            pace = REPLAY_REALTIME;
+        } else if (strcmp(argv[a], "--golden") == 0 && a + 1 < argc) {
+            golden = GOLDEN_CHECK;
+            golden_path = argv[++a];
+        } else if (strcmp(argv[a], "--write-golden") == 0 && a + 1 < argc) {
+            golden = GOLDEN_WRITE;
+            golden_path = argv[++a];
+        } else if (strcmp(argv[a], "--tol") == 0 && a + 1 < argc) {
+            tolerance = strtof(argv[++a], NULL);
+        } else if (strcmp(argv[a], "--repeat") == 0 && a + 1 < argc) {
+            repeat = atoi(argv[++a]);
+        } else if (capture == NULL && argv[a][0] != '-') {
+            capture = argv[a];
+        } else {
+            capture = NULL;
+            break;
+        }
+    }
+
+    if (capture == NULL || repeat < 1) {
+        fprintf(stderr, "usage: %s capture [--realtime] [--repeat N] "
+                        "[--write-golden f | --golden f [--tol x]]\n", argv[0]);
+        return 2;
+    }
+
+    int failures = 0;
+    for (int run = 0; run < repeat; run++) {
+        DemoPipeline pipe;
+        ReplayStats stats;
+
+        // Fresh state per run: identical input gives identical output
+        cb_init(&pipe.buffer);
+        ma_init(&pipe.filter);
+
+        // Only the first run writes the reference
+        GoldenMode mode = (golden == GOLDEN_WRITE && run > 0) ? GOLDEN_CHECK : golden;
+        bool ok = replay_run(capture, pace, demo_process, &pipe,
+                             golden_path, mode, tolerance, &stats);
+
+        printf("run %d: %s\n", run + 1, ok ? "ok" : "FAILED");
+        replay_print_stats(stdout, &stats);
+        if (!ok) {
+            failures++;
+        }
+    }
+
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,176 @@
+/**
+ * Streaming Respiration Rate Implementation
+ */
+
+#include "resp_rate.h"
+#include <math.h>
+
+#define RESP_PI 3.14159265358979323846
+#define RESP_DAMP       0.9999f     // Keeps the sliding DFT numerically stable
+#define RESP_MEAN_ALPHA 0.05f       // Detrend EMA per grid sample (~5 s)
+#define RESP_MIN_HZ     0.13f
+#define RESP_MAX_HZ     0.5f
+
+void resp_init(RespRateEstimator *est, float sample_rate) {
+    est->sample_rate = sample_rate;
+    est->prev_time = 0.0;
+    est->beats_seen = 0;
+    est->next_grid = 0.0;
+    est->grid_head = 0;
+    est->grid_count = 0;
+
+    for (int s = 0; s < RESP_NUM_SERIES; s++) {
+        est->prev[s] = 0.0f;
+        est->mean[s] = 0.0f;
+        for (int i = 0; i < RESP_WINDOW; i++) {
+            est->grid[s][i] = 0.0f;
+        }
+        for (int b = 0; b < RESP_NUM_BINS; b++) {
+            est->re[s][b] = 0.0f;
+            est->im[s][b] = 0.0f;
+        }
+    }
+
+    for (int b = 0; b < RESP_NUM_BINS; b++) {
+        int k = RESP_BIN_MIN - 1 + b;
+        double angle = 2.0 * RESP_PI * k / RESP_WINDOW;
+        est->tw_re[b] = RESP_DAMP * (float)cos(angle);
+        est->tw_im[b] = RESP_DAMP * (float)sin(angle);
+    }
+    est->damp_n = powf(RESP_DAMP, RESP_WINDOW);
+}
+
+// One grid sample for all three series: O(series * bins)
+static void resp_grid_sample(RespRateEstimator *est, const float *value) {
+    for (int s = 0; s < RESP_NUM_SERIES; s++) {
+        if (est->grid_count == 0) {
+            est->mean[s] = value[s];
+        }
+        est->mean[s] += RESP_MEAN_ALPHA * (value[s] - est->mean[s]);
+
+        float x = value[s] - est->mean[s];
+        float delta = x - est->damp_n * est->grid[s][est->grid_head];
+        est->grid[s][est->grid_head] = x;
+
+        for (int b = 0; b < RESP_NUM_BINS; b++) {
+            float r = est->re[s][b] + delta;
+            float i = est->im[s][b];
+            est->re[s][b] = r * est->tw_re[b] - i * est->tw_im[b];
+            est->im[s][b] = r * est->tw_im[b] + i * est->tw_re[b];
+        }
+    }
+
+    est->grid_head = (est->grid_head + 1) % RESP_WINDOW;
+    if (est->grid_count < RESP_WINDOW) {
+        est->grid_count++;
+    }
+}
+
+uint16_t resp_push_beat(RespRateEstimator *est, uint32_t sample_index, float peak, float trough) {
+    double t = sample_index / (double)est->sample_rate;
+    float cur[RESP_NUM_SERIES];
+    uint16_t produced = 0;
+
+    cur[RESP_RIIV] = peak;
+    cur[RESP_RIAV] = peak - trough;
+    cur[RESP_RIFV] = (float)(t - est->prev_time);
+
+    if (est->beats_seen < 2) {
+        // RIFV needs two beats; start the grid at the second one
+        est->beats_seen++;
+        if (est->beats_seen == 2) {
+            for (int s = 0; s < RESP_NUM_SERIES; s++) {
+                est->prev[s] = cur[s];
+            }
+            est->next_grid = t;
+        }
+        est->prev_time = t;
+        return 0;
+    }
+
+    double span = t - est->prev_time;
+    if (span <= 0.0) {
+        return 0;
+    }
+
+    // Linear interpolation between the previous beat and this one
+    while (est->next_grid <= t) {
+        float frac = (float)((est->next_grid - est->prev_time) / span);
+        float v[RESP_NUM_SERIES];
+
+        for (int s = 0; s < RESP_NUM_SERIES; s++) {
+            v[s] = est->prev[s] + frac * (cur[s] - est->prev[s]);
+        }
+        resp_grid_sample(est, v);
+        produced++;
+        est->next_grid += 1.0 / RESP_GRID_HZ;
+    }
+
+    for (int s = 0; s < RESP_NUM_SERIES; s++) {
+        est->prev[s] = cur[s];
+    }
+    est->prev_time = t;
+    return produced;
+}
+
+bool resp_rate(const RespRateEstimator *est, float *bpm, float *confidence) {
+    if (est->grid_count < RESP_WINDOW) {
+        return false;
+    }
+
+    enum { NB = RESP_BIN_MAX - RESP_BIN_MIN + 1 };
+    float fused[NB] = { 0 };
+
+    for (int s = 0; s < RESP_NUM_SERIES; s++) {
+        float power[NB];
+        float total = 0.0f;
+
+        for (int k = 0; k < NB; k++) {
+            int b = k + 1;  // Tracked bins include one guard bin each side
+            // Hann window applied in the frequency domain
+            float hr = 0.5f * est->re[s][b] - 0.25f * (est->re[s][b - 1] + est->re[s][b + 1]);
+            float hi = 0.5f * est->im[s][b] - 0.25f * (est->im[s][b - 1] + est->im[s][b + 1]);
+            power[k] = hr * hr + hi * hi;
+            total += power[k];
+        }
+
+        if (total <= 0.0f) {
+            continue;  // Series carries no modulation (e.g. perfectly regular beats)
+        }
+        for (int k = 0; k < NB; k++) {
+            fused[k] += power[k] / total;
+        }
+    }
+
+    int best = 0;
+    float total = 0.0f;
+    for (int k = 0; k < NB; k++) {
+        total += fused[k];
+        if (fused[k] > fused[best]) {
+            best = k;
+        }
+    }
+    if (total <= 0.0f) {
+        return false;
+    }
+
+    // Parabolic refinement around the peak
+    float offset = 0.0f;
+    if (best > 0 && best < NB - 1) {
+        float a = fused[best - 1];
+        float b = fused[best];
+        float c = fused[best + 1];
+        float denom = a - 2.0f * b + c;
+        if (denom != 0.0f) {
+            offset = 0.5f * (a - c) / denom;
+        }
+    }
+
+    float hz = (RESP_BIN_MIN + best + offset) * RESP_GRID_HZ / (float)RESP_WINDOW;
+    if (hz < RESP_MIN_HZ) hz = RESP_MIN_HZ;
+    if (hz > RESP_MAX_HZ) hz = RESP_MAX_HZ;
+
+    *bpm = hz * 60.0f;
+    *confidence = fused[best] / total;
+    return true;
+}
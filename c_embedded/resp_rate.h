@@ -0,0 +1,82 @@
+/**
+ * Streaming Respiration Rate from PPG Beat Modulations
+ * No respiration sensor, no whole-record FFT
+ *
+ * Breathing modulates the PPG in three ways, each sampled once per beat:
+ * - RIIV: intensity (baseline) variation  -> beat peak value
+ * - RIAV: amplitude variation             -> peak - trough
+ * - RIFV: frequency variation             -> beat-to-beat interval
+ *
+ * The three series are linearly resampled onto a RESP_GRID_HZ grid and
+ * fed to a sliding DFT that only tracks the 0.13-0.5 Hz bins, so each
+ * grid sample costs O(bins). The Hann-windowed spectra are normalized and
+ * fused, and the dominant bin is refined by parabolic interpolation.
+ */
+
+#ifndef RESP_RATE_H
+#define RESP_RATE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define RESP_GRID_HZ    4                       // Resampling grid rate
+#define RESP_WINDOW     128                     // Grid samples per DFT (32 s)
+#define RESP_BIN_MIN    4                       // 0.125 Hz
+#define RESP_BIN_MAX    16                      // 0.5 Hz
+#define RESP_NUM_BINS   (RESP_BIN_MAX - RESP_BIN_MIN + 3)  // +1 each side for Hann
+
+typedef enum {
+    RESP_RIIV = 0,
+    RESP_RIAV,
+    RESP_RIFV,
+    RESP_NUM_SERIES
+} RespSeries;
+
+typedef struct {
+    float sample_rate;                          // PPG sample rate in Hz
+
+    // Previous beat (interpolation start)
+    double prev_time;
+    float prev[RESP_NUM_SERIES];
+    uint8_t beats_seen;
+    double next_grid;                           // Time of next grid sample
+
+    // Detrend + sliding DFT state
+    float mean[RESP_NUM_SERIES];
+    float grid[RESP_NUM_SERIES][RESP_WINDOW];
+    uint16_t grid_head;
+    uint16_t grid_count;
+    float re[RESP_NUM_SERIES][RESP_NUM_BINS];
+    float im[RESP_NUM_SERIES][RESP_NUM_BINS];
+    float tw_re[RESP_NUM_BINS];                 // Per-bin rotation
+    float tw_im[RESP_NUM_BINS];
+    float damp_n;                               // r^N for the outgoing sample
+} RespRateEstimator;
+
+/**
+ * Initialize the estimator
+ * @param est Pointer to RespRateEstimator
+ * @param sample_rate PPG sample rate in Hz (beat indices are in these samples)
+ */
+void resp_init(RespRateEstimator *est, float sample_rate);
+
+/**
+ * Feed one detected beat
+ * @param est Pointer to RespRateEstimator
+ * @param sample_index Sample number of the beat peak
+ * @param peak Peak value of the beat
+ * @param trough Trough (foot) value preceding the peak
+ * @return Number of grid samples produced
+ */
+uint16_t resp_push_beat(RespRateEstimator *est, uint32_t sample_index, float peak, float trough);
+
+/**
+ * Get the current respiration rate estimate
+ * @param est Pointer to RespRateEstimator
+ * @param bpm Breaths per minute output
+ * @param confidence Fraction of fused in-band power at the peak (0..1)
+ * @return true once a full DFT window has been collected
+ */
+bool resp_rate(const RespRateEstimator *est, float *bpm, float *confidence);
+
+#endif // RESP_RATE_H
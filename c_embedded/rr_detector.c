@@ -0,0 +1,228 @@
+/**
+ * RR-Interval Rhythm Detector Implementation
+ */
+
+#include "rr_detector.h"
+#include <math.h>
+
+#define RR_RING_MASK (RR_RING_SIZE - 1)
+#define RR_QUEUE_MASK (RR_EVENT_QUEUE_SIZE - 1)
+#define RR_HYSTERESIS 0.8f          // Irregular offset at 80% of onset score
+#define RR_RATE_MARGIN 0.05f        // Brady/tachy clear 5% inside the limit
+#define RR_JUMP_ONSET 0.4f          // Fraction of large dRR needed for onset
+#define RR_JUMP_OFFSET 0.25f
+
+static void emit(RrDetector *det, RrEventType type, bool onset,
+                 uint32_t sample_index, float value) {
+    RrEventQueue *q = &det->queue;
+    uint32_t head = atomic_load_explicit(&q->head, memory_order_relaxed);
+    uint32_t tail = atomic_load_explicit(&q->tail, memory_order_acquire);
+
+    if (head - tail == RR_EVENT_QUEUE_SIZE) {
+        q->dropped++;
+        return;
+    }
+
+    RrEvent *ev = &q->events[head & RR_QUEUE_MASK];
+    ev->type = type;
+    ev->onset = onset;
+    ev->sample_index = sample_index;
+    ev->value = value;
+
+    // Publish after the slot is written
+    atomic_store_explicit(&q->head, head + 1, memory_order_release);
+}
+
+bool rr_init(RrDetector *det, const RrDetectorConfig *cfg) {
+    if (cfg->sample_rate <= 0.0f || cfg->brady_bpm <= 0.0f ||
+        cfg->tachy_bpm <= cfg->brady_bpm || cfg->pause_ms <= 0.0f ||
+        cfg->irregular_score <= 0.0f) {
+        return false;
+    }
+
+    det->cfg = *cfg;
+    det->pause_samples = (uint32_t)(cfg->pause_ms * cfg->sample_rate / 1000.0f);
+    det->min_rr_samples = (uint32_t)(cfg->min_rr_ms * cfg->sample_rate / 1000.0f);
+
+    for (int i = 0; i < RR_RING_SIZE; i++) {
+        det->rr[i] = 0;
+    }
+    det->head = 0;
+    det->count = 0;
+    det->sum_rr = 0;
+    det->sum_d2 = 0;
+    det->n_jumps = 0;
+    det->sum_rate = 0;
+    det->last_beat = 0;
+    det->have_beat = false;
+    det->irregular = false;
+    det->pause = false;
+    det->brady = false;
+    det->tachy = false;
+
+    atomic_init(&det->queue.head, 0);
+    atomic_init(&det->queue.tail, 0);
+    det->queue.dropped = 0;
+    return true;
+}
+
+static uint64_t diff2(uint32_t a, uint32_t b) {
+    int64_t d = (int64_t)a - (int64_t)b;
+    return (uint64_t)(d * d);
+}
+
+// |next - prev| > prev / 8
+static uint8_t is_jump(uint32_t next, uint32_t prev) {
+    uint32_t d = next > prev ? next - prev : prev - next;
+    return (uint8_t)(8 * d > prev);
+}
+
+static void add_interval(RrDetector *det, uint32_t rr) {
+    if (det->count > 0) {
+        uint32_t prev = det->rr[(det->head - 1) & RR_RING_MASK];
+        det->sum_d2 += diff2(rr, prev);
+        det->n_jumps += is_jump(rr, prev);
+    }
+
+    if (det->count == RR_RING_SIZE) {
+        // head is the oldest slot when full
+        uint32_t oldest = det->rr[det->head];
+        uint32_t second = det->rr[(det->head + 1) & RR_RING_MASK];
+        det->sum_rr -= oldest;
+        det->sum_d2 -= diff2(second, oldest);
+        det->n_jumps -= is_jump(second, oldest);
+    } else {
+        det->count++;
+    }
+
+    det->rr[det->head] = rr;
+    det->head = (det->head + 1) & RR_RING_MASK;
+    det->sum_rr += rr;
+
+    det->sum_rate += rr;
+    if (det->count > RR_RATE_BEATS) {
+        det->sum_rate -= det->rr[(det->head - 1 - RR_RATE_BEATS) & RR_RING_MASK];
+    }
+}
+
+float rr_irregularity(const RrDetector *det) {
+    if (det->count < 2 || det->sum_rr == 0) {
+        return 0.0f;
+    }
+
+    float rmssd = sqrtf((float)det->sum_d2 / (float)(det->count - 1));
+    float mean = (float)det->sum_rr / (float)det->count;
+    return rmssd / mean;
+}
+
+float rr_jump_fraction(const RrDetector *det) {
+    if (det->count < 2) {
+        return 0.0f;
+    }
+    return (float)det->n_jumps / (float)(det->count - 1);
+}
+
+float rr_mean_bpm(const RrDetector *det) {
+    uint8_t n = det->count < RR_RATE_BEATS ? det->count : RR_RATE_BEATS;
+
+    if (n == 0 || det->sum_rate == 0) {
+        return 0.0f;
+    }
+    return 60.0f * det->cfg.sample_rate * (float)n / (float)det->sum_rate;
+}
+
+void rr_push_beat(RrDetector *det, uint32_t sample_index) {
+    if (!det->have_beat) {
+        det->last_beat = sample_index;
+        det->have_beat = true;
+        return;
+    }
+
+    uint32_t rr = sample_index - det->last_beat;
+    if (rr < det->min_rr_samples) {
+        return;  // Double detection, keep the first fiducial
+    }
+    det->last_beat = sample_index;
+
+    if (det->pause) {
+        det->pause = false;
+        emit(det, RR_EVENT_PAUSE, false, sample_index,
+             1000.0f * (float)rr / det->cfg.sample_rate);
+        return;
+    }
+
+    add_interval(det, rr);
+
+    // Rate alerts once half the averaging window is filled
+    if (det->count >= RR_RATE_BEATS / 2) {
+        float bpm = rr_mean_bpm(det);
+
+        if (!det->brady && bpm < det->cfg.brady_bpm) {
+            det->brady = true;
+            emit(det, RR_EVENT_BRADY, true, sample_index, bpm);
+        } else if (det->brady && bpm > det->cfg.brady_bpm * (1.0f + RR_RATE_MARGIN)) {
+            det->brady = false;
+            emit(det, RR_EVENT_BRADY, false, sample_index, bpm);
+        }
+
+        if (!det->tachy && bpm > det->cfg.tachy_bpm) {
+            det->tachy = true;
+            emit(det, RR_EVENT_TACHY, true, sample_index, bpm);
+        } else if (det->tachy && bpm < det->cfg.tachy_bpm * (1.0f - RR_RATE_MARGIN)) {
+            det->tachy = false;
+            emit(det, RR_EVENT_TACHY, false, sample_index, bpm);
+        }
+    }
+
+    // Irregularity needs enough intervals for a stable RMSSD
+    if (det->count >= RR_RING_SIZE / 2) {
+        float score = rr_irregularity(det);
+        float jumps = rr_jump_fraction(det);
+
+        if (!det->irregular && score > det->cfg.irregular_score && jumps > RR_JUMP_ONSET) {
+            det->irregular = true;
+            emit(det, RR_EVENT_IRREGULAR, true, sample_index, score);
+        } else if (det->irregular && (score < det->cfg.irregular_score * RR_HYSTERESIS ||
+                                      jumps < RR_JUMP_OFFSET)) {
+            det->irregular = false;
+            emit(det, RR_EVENT_IRREGULAR, false, sample_index, score);
+        }
+    }
+}
+
+void rr_tick(RrDetector *det, uint32_t sample_index) {
+    if (!det->have_beat || det->pause) {
+        return;
+    }
+
+    uint32_t elapsed = sample_index - det->last_beat;
+    if (elapsed >= det->pause_samples) {
+        det->pause = true;
+        emit(det, RR_EVENT_PAUSE, true, sample_index,
+             1000.0f * (float)elapsed / det->cfg.sample_rate);
+    }
+}
+
+bool rr_event_pop(RrDetector *det, RrEvent *ev) {
+    RrEventQueue *q = &det->queue;
+    uint32_t tail = atomic_load_explicit(&q->tail, memory_order_relaxed);
+    uint32_t head = atomic_load_explicit(&q->head, memory_order_acquire);
+
+    if (tail == head) {
+        return false;
+    }
+
+    *ev = q->events[tail & RR_QUEUE_MASK];
+    atomic_store_explicit(&q->tail, tail + 1, memory_order_release);
+    return true;
+}
+
+const char *rr_event_name(RrEventType type) {
+    switch (type) {
+        case RR_EVENT_IRREGULAR: return "irregular rhythm";
+        case RR_EVENT_PAUSE:     return "pause";
+        case RR_EVENT_BRADY:     return "bradycardia";
+        case RR_EVENT_TACHY:     return "tachycardia";
+        default:                 return "unknown";
+    }
+}
@@ -0,0 +1,142 @@
+/**
+ * RR-Interval Rhythm Detector
+ * Streaming brady / tachy / pause / irregular-rhythm alerts from beat times
+ *
+ * Key points:
+ * - RR intervals are kept in integer samples, so the running sums over the
+ *   ring are exact (add newest, subtract evicted, no drift, O(1) per beat)
+ * - Irregularity score is normalized RMSSD: sqrt(mean(dRR^2)) / mean(RR),
+ *   the usual AF-screening measure. It only alerts when most successive
+ *   differences are large too, so one rate step or one ectopic beat does
+ *   not look like AF. Onset/offset use hysteresis
+ * - Brady/tachy use the mean of the last RR_RATE_BEATS intervals
+ * - Pauses are detected by rr_tick() before the late beat arrives
+ * - Events go into a single-producer single-consumer lock-free queue, so
+ *   the sample path never blocks on the reader
+ */
+
+#ifndef RR_DETECTOR_H
+#define RR_DETECTOR_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+#define RR_RING_SIZE 32             // Power of 2, irregularity window (beats)
+#define RR_RATE_BEATS 8             // Beats averaged for brady/tachy
+#define RR_EVENT_QUEUE_SIZE 16      // Power of 2
+
+typedef enum {
+    RR_EVENT_IRREGULAR = 0,         // value = nRMSSD score
+    RR_EVENT_PAUSE,                 // value = pause length in ms
+    RR_EVENT_BRADY,                 // value = BPM
+    RR_EVENT_TACHY                  // value = BPM
+} RrEventType;
+
+typedef struct {
+    RrEventType type;
+    bool onset;                     // true = condition started, false = ended
+    uint32_t sample_index;          // Timestamp of the beat/tick that raised it
+    float value;
+} RrEvent;
+
+typedef struct {
+    RrEvent events[RR_EVENT_QUEUE_SIZE];
+    _Atomic uint32_t head;          // Written by producer only
+    _Atomic uint32_t tail;          // Written by consumer only
+    uint32_t dropped;               // Events lost because the queue was full
+} RrEventQueue;
+
+typedef struct {
+    float sample_rate;              // Hz
+    float brady_bpm;                // Below this = bradycardia
+    float tachy_bpm;                // Above this = tachycardia
+    float pause_ms;                 // No beat for this long = pause
+    float irregular_score;          // nRMSSD onset threshold (e.g. 0.10)
+    float min_rr_ms;                // Shorter intervals are treated as double detections
+} RrDetectorConfig;
+
+typedef struct {
+    RrDetectorConfig cfg;
+    uint32_t pause_samples;
+    uint32_t min_rr_samples;
+
+    uint32_t rr[RR_RING_SIZE];      // RR in samples
+    uint8_t head;
+    uint8_t count;
+
+    uint32_t sum_rr;                // Over the whole ring
+    uint64_t sum_d2;                // Squared successive differences in the ring
+    uint8_t n_jumps;                // Successive differences > 1/8 of the earlier RR
+    uint32_t sum_rate;              // Over the last RR_RATE_BEATS
+
+    uint32_t last_beat;
+    bool have_beat;                 // Pause intervals are reported, not added to the ring
+
+    bool irregular;                 // Current alert states
+    bool pause;
+    bool brady;
+    bool tachy;
+
+    RrEventQueue queue;
+} RrDetector;
+
+/**
+ * Initialize the detector
+ * @param det Pointer to RrDetector
+ * @param cfg Configuration (copied)
+ * @return true if configuration is valid
+ */
+bool rr_init(RrDetector *det, const RrDetectorConfig *cfg);
+
+/**
+ * Report a detected beat (producer side)
+ * @param det Pointer to RrDetector
+ * @param sample_index Sample index of the beat fiducial
+ */
+void rr_push_beat(RrDetector *det, uint32_t sample_index);
+
+/**
+ * Advance time without a beat so pauses are raised as soon as they start
+ * @param det Pointer to RrDetector
+ * @param sample_index Current sample index
+ */
+void rr_tick(RrDetector *det, uint32_t sample_index);
+
+/**
+ * Pop the oldest event (consumer side, may run on another thread)
+ * @param det Pointer to RrDetector
+ * @param ev Output event
+ * @return true if an event was returned
+ */
+bool rr_event_pop(RrDetector *det, RrEvent *ev);
+
+/**
+ * Get the current irregularity score
+ * @param det Pointer to RrDetector
+ * @return nRMSSD over the ring, 0 until two intervals are known
+ */
+float rr_irregularity(const RrDetector *det);
+
+/**
+ * Get the fraction of successive differences that are large
+ * @param det Pointer to RrDetector
+ * @return 0..1, fraction of dRR exceeding 12.5% of the preceding RR
+ */
+float rr_jump_fraction(const RrDetector *det);
+
+/**
+ * Get the short-term mean heart rate
+ * @param det Pointer to RrDetector
+ * @return BPM over the last RR_RATE_BEATS intervals, 0 if none
+ */
+float rr_mean_bpm(const RrDetector *det);
+
+/**
+ * Get a readable name for an event type
+ * @param type Event type
+ * @return Static string
+ */
+const char *rr_event_name(RrEventType type);
+
+#endif // RR_DETECTOR_H
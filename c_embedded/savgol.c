@@ -0,0 +1,150 @@
+/**
+ * Savitzky-Golay Implementation
+ */
+
+#include "savgol.h"
+#include <math.h>
+#include <stddef.h>
+
+// Invert the (order+1)^2 normal matrix in place (Gauss-Jordan, partial pivot)
+static bool invert(double m[SG_MAX_ORDER + 1][SG_MAX_ORDER + 1], int n,
+                   double inv[SG_MAX_ORDER + 1][SG_MAX_ORDER + 1]) {
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            inv[i][j] = (i == j) ? 1.0 : 0.0;
+        }
+    }
+
+    for (int col = 0; col < n; col++) {
+        int pivot = col;
+        for (int r = col + 1; r < n; r++) {
+            if (fabs(m[r][col]) > fabs(m[pivot][col])) {
+                pivot = r;
+            }
+        }
+        if (fabs(m[pivot][col]) < 1e-12) {
+            return false;
+        }
+        for (int j = 0; j < n; j++) {
+            double t = m[col][j]; m[col][j] = m[pivot][j]; m[pivot][j] = t;
+            t = inv[col][j]; inv[col][j] = inv[pivot][j]; inv[pivot][j] = t;
+        }
+
+        double p = m[col][col];
+        for (int j = 0; j < n; j++) {
+            m[col][j] /= p;
+            inv[col][j] /= p;
+        }
+        for (int r = 0; r < n; r++) {
+            if (r != col) {
+                double f = m[r][col];
+                for (int j = 0; j < n; j++) {
+                    m[r][j] -= f * m[col][j];
+                    inv[r][j] -= f * inv[col][j];
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
+bool savgol_init(SavGol *sg, uint8_t window, uint8_t order, float sample_rate) {
+    if (window < 3 || window > SG_MAX_WINDOW || (window & 1) == 0 ||
+        order > SG_MAX_ORDER || order >= window || sample_rate <= 0.0f) {
+        return false;
+    }
+
+    int n = order + 1;
+    int half = window / 2;
+    double ata[SG_MAX_ORDER + 1][SG_MAX_ORDER + 1];
+    double inv[SG_MAX_ORDER + 1][SG_MAX_ORDER + 1];
+
+    // Normal matrix of the Vandermonde design over t = -half..half
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            double s = 0.0;
+            for (int t = -half; t <= half; t++) {
+                s += pow(t, i + j);
+            }
+            ata[i][j] = s;
+        }
+    }
+    if (!invert(ata, n, inv)) {
+        return false;
+    }
+
+    sg->window = window;
+    sg->half = (uint8_t)half;
+    sg->order = order;
+
+    // Coefficient at offset t for derivative d: d! * sum_j inv[d][j] * t^j
+    for (int k = 0; k <= half; k++) {
+        double v0 = 0.0, v1 = 0.0, v2 = 0.0;
+        for (int j = 0; j < n; j++) {
+            double tj = pow(k, j);
+            v0 += inv[0][j] * tj;
+            if (n > 1) v1 += inv[1][j] * tj;
+            if (n > 2) v2 += inv[2][j] * tj;
+        }
+        sg->c0[k] = (float)v0;
+        sg->c1[k] = (float)(v1 * sample_rate);
+        sg->c2[k] = (float)(2.0 * v2 * sample_rate * sample_rate);
+    }
+
+    savgol_reset(sg);
+    return true;
+}
+
+void savgol_reset(SavGol *sg) {
+    for (int i = 0; i < 2 * SG_MAX_WINDOW; i++) {
+        sg->hist[i] = 0.0f;
+    }
+    sg->pos = 0;
+}
+
+float savgol_filter(SavGol *sg, float x, float *d1, float *d2) {
+    uint8_t w = sg->window;
+
+    // Mirror write keeps hist[pos .. pos + w) contiguous, oldest first
+    sg->hist[sg->pos] = x;
+    sg->hist[sg->pos + w] = x;
+    sg->pos = (sg->pos + 1 == w) ? 0 : sg->pos + 1;
+
+    const float *center = &sg->hist[sg->pos + sg->half];
+    float y = sg->c0[0] * center[0];
+    float y1 = 0.0f;
+    float y2 = sg->c2[0] * center[0];
+
+    for (uint8_t k = 1; k <= sg->half; k++) {
+        float sum = center[k] + center[-k];
+        float diff = center[k] - center[-k];
+        y += sg->c0[k] * sum;
+        y1 += sg->c1[k] * diff;
+        y2 += sg->c2[k] * sum;
+    }
+
+    if (d1 != NULL) {
+        *d1 = y1;
+    }
+    if (d2 != NULL) {
+        *d2 = y2;
+    }
+    return y;
+}
+
+void savgol_process(SavGol *sg, const float *in, uint32_t n,
+                    float *smooth, float *d1, float *d2) {
+    for (uint32_t i = 0; i < n; i++) {
+        float v1, v2;
+        float y = savgol_filter(sg, in[i], &v1, &v2);
+
+        if (smooth != NULL) smooth[i] = y;
+        if (d1 != NULL) d1[i] = v1;
+        if (d2 != NULL) d2[i] = v2;
+    }
+}
+
+uint8_t savgol_delay(const SavGol *sg) {
+    return sg->half;
+}
@@ -0,0 +1,82 @@
+/**
+ * Savitzky-Golay Streaming Smoother and Differentiator
+ * Local polynomial fit as a symmetric FIR - keeps peak height and timing
+ *
+ * Kernels for the smoothed value and the first/second derivative are
+ * least-squares designed once at init for any odd window and polynomial
+ * order, then applied as symmetric / antisymmetric FIRs:
+ *   y = c0 * x[0] + sum_k c_k * (x[+k] +/- x[-k])
+ * which halves the multiplies of a plain FIR of the same length.
+ *
+ * History is stored twice (mirror trick) so every window is contiguous.
+ * Output is centered, so it lags the input by half a window.
+ */
+
+#ifndef SAVGOL_H
+#define SAVGOL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define SG_MAX_WINDOW 31            // Odd
+#define SG_MAX_ORDER  6
+#define SG_MAX_HALF   (SG_MAX_WINDOW / 2)
+
+typedef struct {
+    uint8_t window;                 // Odd window length (3..SG_MAX_WINDOW)
+    uint8_t half;                   // window / 2 (= output delay)
+    uint8_t order;                  // Polynomial order (< window)
+    float c0[SG_MAX_HALF + 1];      // Smoothing kernel, c0[k] for offset +/-k
+    float c1[SG_MAX_HALF + 1];      // First derivative (antisymmetric)
+    float c2[SG_MAX_HALF + 1];      // Second derivative (symmetric)
+
+    float hist[2 * SG_MAX_WINDOW];  // Mirrored history
+    uint8_t pos;
+} SavGol;
+
+/**
+ * Design kernels and clear history
+ * @param sg Pointer to SavGol
+ * @param window Odd window length (3..SG_MAX_WINDOW)
+ * @param order Polynomial order (0..SG_MAX_ORDER, < window)
+ * @param sample_rate Hz; derivatives are scaled to units per second (1 = per sample)
+ * @return true if parameters are valid
+ */
+bool savgol_init(SavGol *sg, uint8_t window, uint8_t order, float sample_rate);
+
+/**
+ * Process one sample
+ * @param sg Pointer to SavGol
+ * @param x Input sample
+ * @param d1 First derivative output (may be NULL)
+ * @param d2 Second derivative output (may be NULL)
+ * @return Smoothed sample, delayed by savgol_delay() samples
+ */
+float savgol_filter(SavGol *sg, float x, float *d1, float *d2);
+
+/**
+ * Process a block of samples
+ * @param sg Pointer to SavGol
+ * @param in Input samples
+ * @param n Number of samples
+ * @param smooth Smoothed output (may be NULL)
+ * @param d1 First derivative output (may be NULL)
+ * @param d2 Second derivative output (may be NULL)
+ */
+void savgol_process(SavGol *sg, const float *in, uint32_t n,
+                    float *smooth, float *d1, float *d2);
+
+/**
+ * Get output delay in samples
+ * @param sg Pointer to SavGol
+ * @return window / 2
+ */
+uint8_t savgol_delay(const SavGol *sg);
+
+/**
+ * Clear the history
+ * @param sg Pointer to SavGol
+ */
+void savgol_reset(SavGol *sg);
+
+#endif // SAVGOL_H
@@ -0,0 +1,103 @@
+/**
+ * Dual-Wavelength SpO2 Estimator Implementation
+ */
+
+#include "spo2.h"
+#include <stddef.h>
+
+const Spo2CalPoint spo2_default_cal[] = {
+    { 0.40f, 100.0f },
+    { 0.50f,  97.5f },
+    { 0.60f,  95.0f },
+    { 0.80f,  90.0f },
+    { 1.00f,  85.0f },
+    { 1.40f,  75.0f },
+    { 2.00f,  60.0f },
+    { 3.40f,  25.0f },
+};
+const uint8_t spo2_default_cal_len = sizeof(spo2_default_cal) / sizeof(spo2_default_cal[0]);
+
+bool spo2_init(Spo2Estimator *est, const Spo2Config *cfg) {
+    if (cfg->table == NULL || cfg->table_len < 2 ||
+        cfg->dc_alpha <= 0.0f || cfg->dc_alpha > 1.0f) {
+        return false;
+    }
+
+    est->cfg = *cfg;
+    for (int c = 0; c < SPO2_CHANNELS; c++) {
+        est->dc[c] = 0.0f;
+        est->beat_max[c] = -1e30f;
+        est->beat_min[c] = 1e30f;
+    }
+    est->primed = false;
+    est->dc_seeded = false;
+    return true;
+}
+
+float spo2_from_ratio(const Spo2CalPoint *table, uint8_t len, float r) {
+    if (r <= table[0].r) {
+        return table[0].spo2;
+    }
+
+    for (uint8_t i = 1; i < len; i++) {
+        if (r <= table[i].r) {
+            float t = (r - table[i - 1].r) / (table[i].r - table[i - 1].r);
+            return table[i - 1].spo2 + t * (table[i].spo2 - table[i - 1].spo2);
+        }
+    }
+
+    return table[len - 1].spo2;
+}
+
+bool spo2_push(Spo2Estimator *est, float red, float ir, bool beat, Spo2Result *out) {
+    const float x[SPO2_CHANNELS] = { red, ir };
+    float ac[SPO2_CHANNELS];
+
+    if (!est->dc_seeded) {
+        est->dc[SPO2_RED] = red;
+        est->dc[SPO2_IR] = ir;
+        est->dc_seeded = true;
+    }
+
+    // Both wavelengths in lockstep (2-wide, branch-free)
+    for (int c = 0; c < SPO2_CHANNELS; c++) {
+        est->dc[c] += est->cfg.dc_alpha * (x[c] - est->dc[c]);
+        est->beat_max[c] = (x[c] > est->beat_max[c]) ? x[c] : est->beat_max[c];
+        est->beat_min[c] = (x[c] < est->beat_min[c]) ? x[c] : est->beat_min[c];
+    }
+
+    if (!beat) {
+        return false;
+    }
+
+    for (int c = 0; c < SPO2_CHANNELS; c++) {
+        ac[c] = est->beat_max[c] - est->beat_min[c];
+        // Next beat starts from the current sample
+        est->beat_max[c] = x[c];
+        est->beat_min[c] = x[c];
+    }
+
+    // First beat only opens the interval
+    if (!est->primed) {
+        est->primed = true;
+        return false;
+    }
+
+    out->valid = false;
+    out->r = 0.0f;
+    out->spo2 = 0.0f;
+    out->perfusion_index = 0.0f;
+
+    if (est->dc[SPO2_RED] <= 0.0f || est->dc[SPO2_IR] <= 0.0f || ac[SPO2_IR] <= 0.0f) {
+        return true;
+    }
+
+    float ratio_red = ac[SPO2_RED] / est->dc[SPO2_RED];
+    float ratio_ir = ac[SPO2_IR] / est->dc[SPO2_IR];
+
+    out->perfusion_index = ratio_ir * 100.0f;
+    out->r = ratio_red / ratio_ir;
+    out->spo2 = spo2_from_ratio(est->cfg.table, est->cfg.table_len, out->r);
+    out->valid = ratio_ir >= est->cfg.min_perfusion;
+    return true;
+}
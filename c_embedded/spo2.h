@@ -0,0 +1,85 @@
+/**
+ * Dual-Wavelength SpO2 Estimator
+ * Ratio-of-ratios pulse oximetry on paired red/IR PPG channels
+ *
+ *   R = (AC_red / DC_red) / (AC_ir / DC_ir)
+ *   SpO2 = calibration(R)
+ *
+ * Key points:
+ * - Red and IR are processed in lockstep as one 2-wide pair
+ * - AC = peak-to-trough between consecutive beats from the peak detector
+ * - DC = long one-pole average (O(1) memory, no sample history)
+ * - One result per beat, constant memory
+ */
+
+#ifndef SPO2_H
+#define SPO2_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define SPO2_RED 0
+#define SPO2_IR  1
+#define SPO2_CHANNELS 2
+
+typedef struct {
+    float r;                    // Ratio of ratios
+    float spo2;                 // Saturation in percent
+} Spo2CalPoint;
+
+typedef struct {
+    float dc_alpha;             // DC tracker rate per sample (e.g. 1 / (2 s * fs))
+    const Spo2CalPoint *table;  // Calibration points sorted by ascending r
+    uint8_t table_len;
+    float min_perfusion;        // Min AC/DC on IR to accept a beat
+} Spo2Config;
+
+typedef struct {
+    float r;
+    float spo2;
+    float perfusion_index;      // AC_ir / DC_ir in percent
+    bool valid;
+} Spo2Result;
+
+typedef struct {
+    Spo2Config cfg;
+    float dc[SPO2_CHANNELS];
+    float beat_max[SPO2_CHANNELS];
+    float beat_min[SPO2_CHANNELS];
+    bool primed;                // First beat seen (AC interval open)
+    bool dc_seeded;
+} Spo2Estimator;
+
+// Generic empirical curve (roughly SpO2 = 110 - 25 R), replace per sensor
+extern const Spo2CalPoint spo2_default_cal[];
+extern const uint8_t spo2_default_cal_len;
+
+/**
+ * Initialize the estimator
+ * @param est Pointer to Spo2Estimator
+ * @param cfg Configuration (copied, table must outlive the estimator)
+ * @return true if configuration is valid
+ */
+bool spo2_init(Spo2Estimator *est, const Spo2Config *cfg);
+
+/**
+ * Push one red/IR sample pair
+ * @param est Pointer to Spo2Estimator
+ * @param red Red channel sample (raw, with DC)
+ * @param ir IR channel sample (raw, with DC)
+ * @param beat true if the peak detector fired on this sample
+ * @param out Result, written when a beat completes
+ * @return true if a per-beat result was written
+ */
+bool spo2_push(Spo2Estimator *est, float red, float ir, bool beat, Spo2Result *out);
+
+/**
+ * Map ratio-of-ratios to SpO2 by linear interpolation in a table
+ * @param table Calibration points sorted by ascending r
+ * @param len Number of points
+ * @param r Ratio of ratios
+ * @return SpO2 in percent (clamped to table end points)
+ */
+float spo2_from_ratio(const Spo2CalPoint *table, uint8_t len, float r);
+
+#endif // SPO2_H
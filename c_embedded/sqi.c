@@ -0,0 +1,265 @@
+/**
+ * Streaming Signal Quality Index Implementation
+ */
+
+#include "sqi.h"
+#include "dsp_dispatch.h"
+#include <math.h>
+
+#define SQI_PI 3.14159265358979323846
+
+// Score weights (sum to 1)
+#define SQI_W_TEMPLATE 0.40f
+#define SQI_W_ENTROPY  0.30f
+#define SQI_W_ZCR      0.15f
+#define SQI_W_KURTOSIS 0.15f
+
+#define SQI_TEMPLATE_ADAPT 0.1f   // Template EMA rate
+#define SQI_TEMPLATE_MATCH 0.8f   // Min correlation to adapt the template
+
+bool sqi_init(SqiEngine *sqi, const SqiConfig *cfg, const FftPlan *plan) {
+    if (plan->n > SQI_MAX_SEG || cfg->window_len == 0 ||
+        cfg->template_len < 4 || cfg->template_len > SQI_MAX_TEMPLATE) {
+        return false;
+    }
+
+    sqi->cfg = *cfg;
+    sqi->plan = plan;
+
+    sqi->ref = 0.0f;
+    sqi->s1 = sqi->s2 = sqi->s3 = sqi->s4 = 0.0f;
+    sqi->n = 0;
+    sqi->crossings = 0;
+    sqi->last_positive = false;
+
+    for (uint16_t i = 0; i < plan->n; i++) {
+        sqi->seg[i] = 0.0f;
+        sqi->window[i] = 0.5f - 0.5f * (float)cos(2.0 * SQI_PI * i / plan->n);
+    }
+    sqi->seg_head = 0;
+    sqi->seg_fill = 0;
+    sqi->since_seg = 0;
+    sqi->psd_head = 0;
+    sqi->psd_count = 0;
+
+    for (int i = 0; i < SQI_HIST_SIZE; i++) {
+        sqi->hist[i] = 0.0f;
+    }
+    sqi->hist_head = 0;
+    sqi->pending = -1;
+    sqi->templ_ready = false;
+    sqi->corr_sum = 0.0f;
+    sqi->corr_count = 0;
+
+    sqi->last = (SqiResult){ 0 };
+    return true;
+}
+
+// Periodogram of the latest segment into the PSD ring
+static void sqi_welch_segment(SqiEngine *sqi) {
+    uint16_t n = sqi->plan->n;
+    uint16_t bins = n / 2 + 1;
+    uint16_t mask = SQI_MAX_SEG - 1;
+    uint16_t idx = (sqi->seg_head - n) & mask;
+
+    // Constant detrend
+    float mean = 0.0f;
+    for (uint16_t i = 0; i < n; i++) {
+        mean += sqi->seg[(idx + i) & mask];
+    }
+    mean /= n;
+
+    for (uint16_t i = 0; i < n; i++) {
+        sqi->work[2 * i] = (sqi->seg[(idx + i) & mask] - mean) * sqi->window[i];
+        sqi->work[2 * i + 1] = 0.0f;
+    }
+    fft_forward(sqi->plan, sqi->work);
+
+    float *p = sqi->psd[sqi->psd_head];
+    for (uint16_t k = 0; k < bins; k++) {
+        float re = sqi->work[2 * k];
+        float im = sqi->work[2 * k + 1];
+        p[k] = re * re + im * im;
+    }
+
+    sqi->psd_head = (sqi->psd_head + 1) % SQI_WELCH_SEGS;
+    if (sqi->psd_count < SQI_WELCH_SEGS) {
+        sqi->psd_count++;
+    }
+
+    // Re-sum instead of add/subtract so float error never accumulates
+    for (uint16_t k = 0; k < bins; k++) {
+        float sum = 0.0f;
+        for (uint8_t s = 0; s < sqi->psd_count; s++) {
+            sum += sqi->psd[s][k];
+        }
+        sqi->psd_sum[k] = sum;
+    }
+}
+
+// Correlate the beat-centered segment with the template
+static void sqi_beat_segment(SqiEngine *sqi) {
+    uint16_t len = sqi->cfg.template_len;
+    uint16_t mask = SQI_HIST_SIZE - 1;
+    uint16_t idx = (sqi->hist_head - len) & mask;
+    float segment[SQI_MAX_TEMPLATE];
+
+    float mean = 0.0f;
+    for (uint16_t i = 0; i < len; i++) {
+        segment[i] = sqi->hist[(idx + i) & mask];
+        mean += segment[i];
+    }
+    mean /= len;
+
+    for (uint16_t i = 0; i < len; i++) {
+        segment[i] -= mean;
+    }
+    float norm = sqrtf(dsp_kernels.dot_f32(segment, segment, len));
+    if (norm < 1e-9f) {
+        return;  // Flat segment, nothing to compare
+    }
+    for (uint16_t i = 0; i < len; i++) {
+        segment[i] /= norm;
+    }
+
+    if (!sqi->templ_ready) {
+        for (uint16_t i = 0; i < len; i++) {
+            sqi->templ[i] = segment[i];
+        }
+        sqi->templ_ready = true;
+        return;
+    }
+
+    // Both vectors are zero-mean and unit-norm: dot = Pearson correlation
+    float corr = dsp_kernels.dot_f32(segment, sqi->templ, len);
+    sqi->corr_sum += corr;
+    sqi->corr_count++;
+
+    if (corr > SQI_TEMPLATE_MATCH) {
+        for (uint16_t i = 0; i < len; i++) {
+            sqi->templ[i] += SQI_TEMPLATE_ADAPT * (segment[i] - sqi->templ[i]);
+        }
+        float tn = sqrtf(dsp_kernels.dot_f32(sqi->templ, sqi->templ, len));
+        for (uint16_t i = 0; i < len; i++) {
+            sqi->templ[i] /= tn;
+        }
+    }
+}
+
+static void sqi_finish_window(SqiEngine *sqi) {
+    SqiResult *r = &sqi->last;
+    float n = (float)sqi->n;
+
+    // Central moments from moments about ref
+    float m1 = sqi->s1 / n;
+    float e2 = sqi->s2 / n;
+    float e3 = sqi->s3 / n;
+    float e4 = sqi->s4 / n;
+    float m2 = e2 - m1 * m1;
+    float m3 = e3 - 3.0f * m1 * e2 + 2.0f * m1 * m1 * m1;
+    float m4 = e4 - 4.0f * m1 * e3 + 6.0f * m1 * m1 * e2 - 3.0f * m1 * m1 * m1 * m1;
+
+    if (m2 > 1e-12f) {
+        r->skewness = m3 / (m2 * sqrtf(m2));
+        r->kurtosis = m4 / (m2 * m2);
+    } else {
+        r->skewness = 0.0f;
+        r->kurtosis = 0.0f;
+    }
+
+    r->zcr = sqi->crossings / n;
+
+    // Normalized spectral entropy
+    r->spectral_entropy = 1.0f;
+    if (sqi->psd_count > 0) {
+        uint16_t bins = sqi->plan->n / 2 + 1;
+        float total = 0.0f;
+        for (uint16_t k = 0; k < bins; k++) {
+            total += sqi->psd_sum[k];
+        }
+        if (total > 0.0f) {
+            float h = 0.0f;
+            for (uint16_t k = 0; k < bins; k++) {
+                float p = sqi->psd_sum[k] / total;
+                if (p > 0.0f) {
+                    h -= p * log2f(p);
+                }
+            }
+            r->spectral_entropy = h / log2f((float)bins);
+        }
+    }
+
+    r->beats = sqi->corr_count;
+    r->template_corr = (sqi->corr_count > 0) ? sqi->corr_sum / sqi->corr_count : 0.0f;
+
+    float corr_term = r->template_corr < 0.0f ? 0.0f : r->template_corr;
+    bool kurt_ok = r->kurtosis >= sqi->cfg.kurtosis_min && r->kurtosis <= sqi->cfg.kurtosis_max;
+
+    r->score = SQI_W_TEMPLATE * corr_term +
+               SQI_W_ENTROPY * (1.0f - r->spectral_entropy) +
+               SQI_W_ZCR * (r->zcr <= sqi->cfg.zcr_max ? 1.0f : 0.0f) +
+               SQI_W_KURTOSIS * (kurt_ok ? 1.0f : 0.0f);
+    if (m2 <= 1e-12f) {
+        r->score = 0.0f;  // Flat line: lead off / sensor detached
+    }
+    r->usable = r->score >= sqi->cfg.min_score;
+
+    // Next window is referenced to this window's mean
+    sqi->ref += m1;
+    sqi->s1 = sqi->s2 = sqi->s3 = sqi->s4 = 0.0f;
+    sqi->n = 0;
+    sqi->crossings = 0;
+    sqi->corr_sum = 0.0f;
+    sqi->corr_count = 0;
+}
+
+bool sqi_push(SqiEngine *sqi, float x, bool beat) {
+    // Incremental moments + zero crossings
+    float d = x - sqi->ref;
+    float d2 = d * d;
+    sqi->s1 += d;
+    sqi->s2 += d2;
+    sqi->s3 += d2 * d;
+    sqi->s4 += d2 * d2;
+
+    bool positive = d >= 0.0f;
+    if (sqi->n > 0 && positive != sqi->last_positive) {
+        sqi->crossings++;
+    }
+    sqi->last_positive = positive;
+    sqi->n++;
+
+    // Welch segments every half segment
+    uint16_t seg_len = sqi->plan->n;
+    sqi->seg[sqi->seg_head] = x;
+    sqi->seg_head = (sqi->seg_head + 1) & (SQI_MAX_SEG - 1);
+    if (sqi->seg_fill < seg_len) {
+        sqi->seg_fill++;
+    }
+    if (++sqi->since_seg >= seg_len / 2 && sqi->seg_fill == seg_len) {
+        sqi->since_seg = 0;
+        sqi_welch_segment(sqi);
+    }
+
+    // Beat segments, extracted once the beat is centered
+    sqi->hist[sqi->hist_head] = x;
+    sqi->hist_head = (sqi->hist_head + 1) & (SQI_HIST_SIZE - 1);
+    if (beat && sqi->pending < 0) {
+        sqi->pending = (int16_t)(sqi->cfg.template_len - sqi->cfg.template_len / 2);
+    }
+    if (sqi->pending > 0 && --sqi->pending == 0) {
+        sqi->pending = -1;
+        sqi_beat_segment(sqi);
+    }
+
+    if (sqi->n >= sqi->cfg.window_len) {
+        sqi_finish_window(sqi);
+        return true;
+    }
+
+    return false;
+}
+
+const SqiResult *sqi_result(const SqiEngine *sqi) {
+    return &sqi->last;
+}
@@ -0,0 +1,108 @@
+/**
+ * Streaming Signal Quality Index (SQI)
+ * Per-window quality score from statistical, spectral and template features
+ *
+ * Features per window:
+ * - Skewness / kurtosis from incremental moments (O(1) per sample)
+ * - Zero-crossing rate about the previous window mean
+ * - Normalized spectral entropy of a sliding Welch PSD (50% overlap)
+ * - Mean correlation of detected beats against an adaptive template
+ *
+ * Downstream HR/HRV stages can check SqiResult.usable and skip bad
+ * windows before doing any work on them.
+ */
+
+#ifndef SQI_H
+#define SQI_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "fft.h"
+
+#define SQI_MAX_SEG       256   // Welch segment length, power of 2
+#define SQI_MAX_BINS      (SQI_MAX_SEG / 2 + 1)
+#define SQI_WELCH_SEGS    8     // Segments averaged in the sliding PSD
+#define SQI_MAX_TEMPLATE  128   // Beat template length
+#define SQI_HIST_SIZE     256   // Beat history ring, power of 2, >= SQI_MAX_TEMPLATE
+
+typedef struct {
+    uint16_t window_len;        // Samples per quality window
+    uint16_t template_len;      // Samples per beat segment, centered on the beat
+    float zcr_max;              // Max plausible zero-crossings per sample
+    float kurtosis_min;         // Plausible kurtosis range
+    float kurtosis_max;
+    float min_score;            // Score needed for usable = true
+} SqiConfig;
+
+typedef struct {
+    float skewness;
+    float kurtosis;             // Non-excess (Gaussian = 3)
+    float zcr;                  // Zero crossings per sample
+    float spectral_entropy;     // 0 = pure tone, 1 = white
+    float template_corr;        // Mean beat correlation, 0 if no beats
+    uint16_t beats;             // Beats compared in this window
+    float score;                // 0..1
+    bool usable;
+} SqiResult;
+
+typedef struct {
+    SqiConfig cfg;
+    const FftPlan *plan;        // Shared plan, plan->n = Welch segment length
+
+    // Moments about the previous window mean
+    float ref;
+    float s1, s2, s3, s4;
+    uint16_t n;
+    uint16_t crossings;
+    bool last_positive;
+
+    // Sliding Welch PSD
+    float seg[SQI_MAX_SEG];
+    uint16_t seg_head;
+    uint16_t seg_fill;
+    uint16_t since_seg;
+    float window[SQI_MAX_SEG];
+    float work[2 * SQI_MAX_SEG];
+    float psd[SQI_WELCH_SEGS][SQI_MAX_BINS];
+    float psd_sum[SQI_MAX_BINS];
+    uint8_t psd_head;
+    uint8_t psd_count;
+
+    // Beat template
+    float hist[SQI_HIST_SIZE];
+    uint16_t hist_head;
+    int16_t pending;            // Samples until a detected beat is centered, -1 if none
+    float templ[SQI_MAX_TEMPLATE];
+    bool templ_ready;
+    float corr_sum;
+    uint16_t corr_count;
+
+    SqiResult last;
+} SqiEngine;
+
+/**
+ * Initialize the SQI engine
+ * @param sqi Pointer to SqiEngine
+ * @param cfg Configuration (copied)
+ * @param plan FFT plan shared between channels, plan->n <= SQI_MAX_SEG
+ * @return true if configuration is valid
+ */
+bool sqi_init(SqiEngine *sqi, const SqiConfig *cfg, const FftPlan *plan);
+
+/**
+ * Push one sample
+ * @param sqi Pointer to SqiEngine
+ * @param x Sample value
+ * @param beat true if the peak detector fired on this sample
+ * @return true if a window completed (result available via sqi_result)
+ */
+bool sqi_push(SqiEngine *sqi, float x, bool beat);
+
+/**
+ * Get the result of the most recently completed window
+ * @param sqi Pointer to SqiEngine
+ * @return Pointer to last result
+ */
+const SqiResult *sqi_result(const SqiEngine *sqi);
+
+#endif // SQI_H
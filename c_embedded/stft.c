@@ -0,0 +1,143 @@
+/**
+ * Streaming STFT Implementation
+ */
+
+#include "stft.h"
+#include "dsp_dispatch.h"
+#include <math.h>
+#include <stddef.h>
+
+#define STFT_PI 3.14159265358979323846
+
+bool stft_init(Stft *st, const StftConfig *cfg) {
+    if (cfg->frame_len > STFT_MAX_FRAME || cfg->hop == 0 ||
+        cfg->hop > cfg->frame_len || cfg->db_range <= 0.0f) {
+        return false;
+    }
+    if (!fft_init(&st->plan, cfg->frame_len)) {
+        return false;
+    }
+
+    st->cfg = *cfg;
+
+    // Periodic Hann window
+    float window_sum = 0.0f;
+    for (uint16_t i = 0; i < cfg->frame_len; i++) {
+        st->window[i] = 0.5f - 0.5f * (float)cos(2.0 * STFT_PI * i / cfg->frame_len);
+        window_sum += st->window[i];
+    }
+    st->mag_scale = 2.0f / window_sum;  // Sine amplitude -> magnitude
+
+    for (uint16_t i = 0; i < STFT_MAX_FRAME; i++) {
+        st->input[i] = 0.0f;
+    }
+    st->in_head = 0;
+    st->in_count = 0;
+    st->since_hop = 0;
+    st->out_head = 0;
+    st->out_count = 0;
+    st->frame_index = 0;
+
+    return true;
+}
+
+static void stft_compute_frame(Stft *st) {
+    uint16_t n = st->cfg.frame_len;
+    uint16_t bins = n / 2 + 1;
+    uint16_t mask = STFT_MAX_FRAME - 1;
+    uint16_t idx = (st->in_head - n) & mask;  // Oldest sample of the frame
+
+    // Unwrap + window straight into the FFT buffer
+    for (uint16_t i = 0; i < n; i++) {
+        st->work[2 * i] = st->input[idx] * st->window[i];
+        st->work[2 * i + 1] = 0.0f;
+        idx = (idx + 1) & mask;
+    }
+
+    fft_forward(&st->plan, st->work);
+
+    float *mag = st->frames[st->out_head];
+    uint8_t *disp = st->frames_u8[st->out_head];
+
+    dsp_kernels.cmag_f32(st->work, mag, bins);
+
+    float scale_u8 = 255.0f / st->cfg.db_range;
+    for (uint16_t k = 0; k < bins; k++) {
+        float m = mag[k] * st->mag_scale;
+        float db = 20.0f * log10f(m + 1e-12f);
+        float q = (db - st->cfg.db_floor) * scale_u8;
+
+        mag[k] = st->cfg.log_scale ? db : m;
+        disp[k] = (q <= 0.0f) ? 0 : (q >= 255.0f) ? 255 : (uint8_t)(q + 0.5f);
+    }
+
+    st->out_head = (st->out_head + 1) & (STFT_NUM_FRAMES - 1);
+    if (st->out_count < STFT_NUM_FRAMES) {
+        st->out_count++;
+    }
+    st->frame_index++;
+}
+
+bool stft_push(Stft *st, float x) {
+    st->input[st->in_head] = x;
+    st->in_head = (st->in_head + 1) & (STFT_MAX_FRAME - 1);
+
+    if (st->in_count < st->cfg.frame_len) {
+        st->in_count++;
+    }
+    st->since_hop++;
+
+    // First frame once the window is full, then every hop
+    if (st->in_count == st->cfg.frame_len && st->since_hop >= st->cfg.hop) {
+        st->since_hop = 0;
+        stft_compute_frame(st);
+        return true;
+    }
+
+    return false;
+}
+
+uint16_t stft_push_block(Stft *st, const float *x, uint16_t n) {
+    uint16_t frames = 0;
+
+    for (uint16_t i = 0; i < n; i++) {
+        frames += stft_push(st, x[i]);
+    }
+
+    return frames;
+}
+
+uint16_t stft_consume(Stft *st, CircularBuffer *cb) {
+    uint16_t frames = 0;
+    float x;
+
+    while (cb_pop(cb, &x)) {
+        frames += stft_push(st, x);
+    }
+
+    return frames;
+}
+
+const float *stft_frame(const Stft *st, uint16_t age) {
+    if (age >= st->out_count) {
+        return NULL;
+    }
+
+    return st->frames[(st->out_head - 1 - age) & (STFT_NUM_FRAMES - 1)];
+}
+
+const uint8_t *stft_frame_u8(const Stft *st, uint16_t age) {
+    if (age >= st->out_count) {
+        return NULL;
+    }
+
+    return st->frames_u8[(st->out_head - 1 - age) & (STFT_NUM_FRAMES - 1)];
+}
+
+uint16_t stft_num_bins(const Stft *st) {
+    return st->cfg.frame_len / 2 + 1;
+}
+
+uint16_t stft_frames_available(const Stft *st) {
+    return st->out_count;
+}
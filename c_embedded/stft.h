@@ -0,0 +1,117 @@
+/**
+ * Streaming STFT Spectrogram Engine
+ * Hop-based short-time Fourier transform for live time-frequency display
+ *
+ * Samples go into a power-of-2 input ring (same indexing as
+ * CircularBuffer). Every `hop` samples the latest `frame_len` samples are
+ * windowed, transformed with one FFT from a reusable plan, and the
+ * magnitude spectrum is written into a ring of output frames.
+ *
+ * Cost per hop: one FFT + one magnitude pass. Nothing is recomputed.
+ */
+
+#ifndef STFT_H
+#define STFT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "fft.h"
+#include "circular_buffer.h"
+
+#define STFT_MAX_FRAME  512                     // Power of 2, <= FFT_MAX_SIZE
+#define STFT_MAX_BINS   (STFT_MAX_FRAME / 2 + 1)
+#define STFT_NUM_FRAMES 64                      // Output ring depth, power of 2
+
+typedef struct {
+    uint16_t frame_len;     // FFT size, power of 2 (<= STFT_MAX_FRAME)
+    uint16_t hop;           // Samples between frames (1..frame_len)
+    bool log_scale;         // Store dB instead of linear magnitude
+    float db_floor;         // dB mapped to 0 in the uint8 frames
+    float db_range;         // dB span mapped to 0..255
+} StftConfig;
+
+typedef struct {
+    StftConfig cfg;
+    FftPlan plan;
+    float window[STFT_MAX_FRAME];
+    float work[2 * STFT_MAX_FRAME];             // FFT scratch (interleaved)
+
+    // Input ring
+    float input[STFT_MAX_FRAME];
+    uint16_t in_head;
+    uint16_t in_count;                          // Saturates at frame_len
+    uint16_t since_hop;
+
+    // Output frame ring
+    float frames[STFT_NUM_FRAMES][STFT_MAX_BINS];
+    uint8_t frames_u8[STFT_NUM_FRAMES][STFT_MAX_BINS];
+    uint16_t out_head;                          // Next frame slot
+    uint16_t out_count;
+    uint32_t frame_index;                       // Total frames produced
+    float mag_scale;                            // 2 / sum(window)
+} Stft;
+
+/**
+ * Initialize STFT engine and build its FFT plan and Hann window
+ * @param st Pointer to Stft
+ * @param cfg Configuration (copied)
+ * @return true if configuration is valid
+ */
+bool stft_init(Stft *st, const StftConfig *cfg);
+
+/**
+ * Push one sample
+ * @param st Pointer to Stft
+ * @param x Input sample
+ * @return true if a new frame was produced
+ */
+bool stft_push(Stft *st, float x);
+
+/**
+ * Push a block of samples
+ * @param st Pointer to Stft
+ * @param x Input samples
+ * @param n Number of samples
+ * @return Number of frames produced
+ */
+uint16_t stft_push_block(Stft *st, const float *x, uint16_t n);
+
+/**
+ * Drain all samples currently held in a CircularBuffer into the STFT
+ * @param st Pointer to Stft
+ * @param cb Source buffer (samples are popped)
+ * @return Number of frames produced
+ */
+uint16_t stft_consume(Stft *st, CircularBuffer *cb);
+
+/**
+ * Get a magnitude frame (linear or dB depending on config)
+ * @param st Pointer to Stft
+ * @param age 0 = newest frame
+ * @return Pointer to stft_num_bins() values, NULL if not available
+ */
+const float *stft_frame(const Stft *st, uint16_t age);
+
+/**
+ * Get a display frame quantized to uint8
+ * @param st Pointer to Stft
+ * @param age 0 = newest frame
+ * @return Pointer to stft_num_bins() values, NULL if not available
+ */
+const uint8_t *stft_frame_u8(const Stft *st, uint16_t age);
+
+/**
+ * Get number of frequency bins per frame (frame_len / 2 + 1)
+ * @param st Pointer to Stft
+ * @return Number of bins
+ */
+uint16_t stft_num_bins(const Stft *st);
+
+/**
+ * Get number of frames held in the output ring
+ * @param st Pointer to Stft
+ * @return Number of frames (<= STFT_NUM_FRAMES)
+ */
+uint16_t stft_frames_available(const Stft *st);
+
+#endif // STFT_H
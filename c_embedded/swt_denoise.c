@@ -0,0 +1,108 @@
+/**
+ * Stationary Wavelet Transform Denoiser Implementation
+ */
+
+#include "swt_denoise.h"
+#include <math.h>
+#include <string.h>
+
+#define SWT_SQRT_PI_2 1.2533141f  // sigma = sqrt(pi/2) * E|w| for Gaussian noise
+
+bool swt_init(SwtDenoiser *swt, const SwtConfig *cfg) {
+    if (cfg->levels < 1 || cfg->levels > SWT_MAX_LEVELS ||
+        cfg->sigma_alpha <= 0.0f || cfg->sigma_alpha > 1.0f) {
+        return false;
+    }
+
+    swt->cfg = *cfg;
+    swt_reset(swt);
+    return true;
+}
+
+void swt_reset(SwtDenoiser *swt) {
+    memset(swt->hist, 0, sizeof(swt->hist));
+    swt->sigma = 0.0f;
+    swt->primed = false;
+}
+
+static float shrink(float w, float t, SwtThreshMode mode) {
+    float mag = fabsf(w);
+
+    if (mode == SWT_THRESH_HARD) {
+        return (mag > t) ? w : 0.0f;
+    }
+
+    float s = mag - t;
+    return (s > 0.0f) ? copysignf(s, w) : 0.0f;
+}
+
+static void swt_block(SwtDenoiser *swt, const float *in, float *out, uint16_t n) {
+    float approx[SWT_MAX_BLOCK];
+    float detail[SWT_MAX_BLOCK];
+    float acc[SWT_MAX_BLOCK];
+
+    memcpy(approx, in, n * sizeof(float));
+    for (uint16_t i = 0; i < n; i++) {
+        acc[i] = 0.0f;
+    }
+
+    for (uint8_t j = 0; j < swt->cfg.levels; j++) {
+        uint16_t s = (uint16_t)(1u << j);
+        float *h = swt->hist[j];   // h[0..s) = previous samples, h[s..s+n) = block
+
+        memcpy(h + s, approx, n * sizeof(float));
+
+        // Lifting step: predict then update (vectorizable, no wrap)
+        for (uint16_t i = 0; i < n; i++) {
+            float d = h[s + i] - h[i];
+            approx[i] = h[i] + 0.5f * d;
+            detail[i] = 0.5f * d;   // a_j - a_{j+1}
+        }
+
+        // Carry the last s samples into the next block's history
+        memmove(h, h + n, s * sizeof(float));
+
+        if (j == 0) {
+            // Noise tracking on the finest band
+            float abs_sum = 0.0f;
+            for (uint16_t i = 0; i < n; i++) {
+                abs_sum += fabsf(detail[i]);
+            }
+            float block_sigma = SWT_SQRT_PI_2 * abs_sum / n;
+
+            if (swt->primed) {
+                swt->sigma += swt->cfg.sigma_alpha * (block_sigma - swt->sigma);
+            } else {
+                swt->sigma = block_sigma;
+            }
+        }
+
+        float t = swt->cfg.threshold_k * swt_noise_sigma(swt, j);
+        for (uint16_t i = 0; i < n; i++) {
+            acc[i] += shrink(detail[i], t, swt->cfg.mode);
+        }
+    }
+
+    swt->primed = true;
+
+    // Reconstruction: coarsest approximation + kept details
+    for (uint16_t i = 0; i < n; i++) {
+        out[i] = approx[i] + acc[i];
+    }
+}
+
+void swt_process(SwtDenoiser *swt, const float *in, float *out, uint32_t n) {
+    while (n > 0) {
+        uint16_t chunk = (n > SWT_MAX_BLOCK) ? SWT_MAX_BLOCK : (uint16_t)n;
+
+        swt_block(swt, in, out, chunk);
+        in += chunk;
+        out += chunk;
+        n -= chunk;
+    }
+}
+
+float swt_noise_sigma(const SwtDenoiser *swt, uint8_t level) {
+    // White noise variance halves per level (a_j averages 2^j samples)
+    return swt->sigma / sqrtf((float)(1u << level));
+}
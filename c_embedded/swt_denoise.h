@@ -0,0 +1,79 @@
+/**
+ * Stationary Wavelet Transform Denoiser
+ * Undecimated (a trous) Haar transform with wavelet shrinkage
+ *
+ * Each level is one lifting step on samples spaced 2^j apart:
+ *   predict: d[n] = a[n] - a[n - 2^j]
+ *   update:  a'[n] = a[n - 2^j] + d[n] / 2
+ * The transform is causal, so the output has zero added latency, and
+ * reconstruction is simply a_J + sum of (thresholded) detail bands.
+ *
+ * Key points:
+ * - Block processing, state carried across blocks (no edge artifacts)
+ * - Per-level history kept contiguous with the block, so every inner
+ *   loop is a straight array pass the compiler can vectorize
+ * - Noise tracked on the finest band (mean |detail|) and scaled to the
+ *   coarser bands, so signal energy there does not inflate the threshold
+ */
+
+#ifndef SWT_DENOISE_H
+#define SWT_DENOISE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define SWT_MAX_LEVELS 6
+#define SWT_MAX_HIST   (1 << (SWT_MAX_LEVELS - 1))  // Spacing of the deepest level
+#define SWT_MAX_BLOCK  128                          // Internal block size
+
+typedef enum {
+    SWT_THRESH_SOFT = 0,    // Shrink toward zero (smoother)
+    SWT_THRESH_HARD         // Keep or kill (preserves amplitude)
+} SwtThreshMode;
+
+typedef struct {
+    uint8_t levels;                 // 1..SWT_MAX_LEVELS
+    SwtThreshMode mode;
+    float threshold_k;              // Threshold = k * noise sigma of the level
+    float sigma_alpha;              // Noise tracker rate per block (0..1]
+} SwtConfig;
+
+typedef struct {
+    SwtConfig cfg;
+    float hist[SWT_MAX_LEVELS][SWT_MAX_HIST + SWT_MAX_BLOCK];
+    float sigma;                    // Noise sigma of the finest band
+    bool primed;                    // Sigma initialized from first block
+} SwtDenoiser;
+
+/**
+ * Initialize the denoiser
+ * @param swt Pointer to SwtDenoiser
+ * @param cfg Configuration (copied)
+ * @return true if configuration is valid
+ */
+bool swt_init(SwtDenoiser *swt, const SwtConfig *cfg);
+
+/**
+ * Denoise a block of samples (any length, in-place allowed)
+ * @param swt Pointer to SwtDenoiser
+ * @param in Input samples
+ * @param out Output samples
+ * @param n Number of samples
+ */
+void swt_process(SwtDenoiser *swt, const float *in, float *out, uint32_t n);
+
+/**
+ * Get current noise estimate for a level
+ * @param swt Pointer to SwtDenoiser
+ * @param level Level index (0 = finest)
+ * @return Estimated noise sigma of that detail band (white-noise model)
+ */
+float swt_noise_sigma(const SwtDenoiser *swt, uint8_t level);
+
+/**
+ * Clear history and noise estimates
+ * @param swt Pointer to SwtDenoiser
+ */
+void swt_reset(SwtDenoiser *swt);
+
+#endif // SWT_DENOISE_H
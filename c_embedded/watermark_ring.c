@@ -0,0 +1,204 @@
+/**
+ * Watermark Ring Implementation
+ */
+
+#define _GNU_SOURCE
+#include "watermark_ring.h"
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+
+#define WR_MASK (WR_SIZE - 1)
+
+#if defined(__x86_64__) || defined(__i386__)
+#define cpu_relax() __builtin_ia32_pause()
+#elif defined(__aarch64__)
+#define cpu_relax() __asm__ __volatile__("yield")
+#else
+#define cpu_relax() ((void)0)
+#endif
+
+typedef uint32_t (*LevelFn)(WatermarkRing *r);
+
+static void futex_wait(_Atomic uint32_t *word, uint32_t expected, const struct timespec *rel) {
+    syscall(SYS_futex, (uint32_t *)word, FUTEX_WAIT_PRIVATE, expected, rel, NULL, 0);
+}
+
+static void futex_wake_all(_Atomic uint32_t *word) {
+    syscall(SYS_futex, (uint32_t *)word, FUTEX_WAKE_PRIVATE, 0x7FFFFFFF, NULL, NULL, 0);
+}
+
+// head/tail use seq_cst so "publish level, read need" on one side and
+// "publish need, read level" on the other cannot both miss each other
+static uint32_t readable(WatermarkRing *r) {
+    return atomic_load(&r->head) - atomic_load(&r->tail);
+}
+
+static uint32_t writable(WatermarkRing *r) {
+    return WR_SIZE - readable(r);
+}
+
+static void notify(WatermarkRing *r, _Atomic uint32_t *need, _Atomic uint32_t *seq,
+                   uint32_t level) {
+    uint32_t want = atomic_load(need);
+
+    if (want == 0 || level < want) {
+        return;  // Nobody parked, or not at their watermark yet
+    }
+    if (atomic_compare_exchange_strong(need, &want, 0)) {
+        atomic_fetch_add_explicit(seq, 1, memory_order_release);
+        futex_wake_all(seq);
+        atomic_fetch_add_explicit(&r->wakes, 1, memory_order_relaxed);
+    }
+}
+
+static int64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+static bool wait_for(WatermarkRing *r, _Atomic uint32_t *need, _Atomic uint32_t *seq,
+                     LevelFn level, uint32_t n, int timeout_ms) {
+    if (level(r) >= n) {
+        return true;
+    }
+
+    // Spin phase: cheap when the peer is about to deliver
+    uint32_t spin = atomic_load_explicit(&r->spin_limit, memory_order_relaxed);
+    for (uint32_t i = 0; i < spin; i++) {
+        cpu_relax();
+        if (level(r) >= n) {
+            uint32_t grown = (spin * 2 < WR_MAX_SPIN) ? spin * 2 : WR_MAX_SPIN;
+            atomic_store_explicit(&r->spin_limit, grown, memory_order_relaxed);
+            atomic_fetch_add_explicit(&r->spin_hits, 1, memory_order_relaxed);
+            return true;
+        }
+    }
+    uint32_t shrunk = (spin / 2 > WR_MIN_SPIN) ? spin / 2 : WR_MIN_SPIN;
+    atomic_store_explicit(&r->spin_limit, shrunk, memory_order_relaxed);
+
+    int64_t deadline = (timeout_ms >= 0) ? now_ns() + (int64_t)timeout_ms * 1000000 : 0;
+
+    // Park phase
+    for (;;) {
+        uint32_t s = atomic_load_explicit(seq, memory_order_acquire);
+        atomic_store(need, n);
+
+        if (level(r) >= n) {
+            atomic_store(need, 0);
+            return true;
+        }
+        if (atomic_load(&r->closed)) {
+            atomic_store(need, 0);
+            return false;
+        }
+
+        struct timespec rel;
+        const struct timespec *timeout = NULL;
+        if (timeout_ms >= 0) {
+            int64_t left = deadline - now_ns();
+            if (left <= 0) {
+                atomic_store(need, 0);
+                return level(r) >= n;
+            }
+            rel.tv_sec = (time_t)(left / 1000000000);
+            rel.tv_nsec = (long)(left % 1000000000);
+            timeout = &rel;
+        }
+
+        atomic_fetch_add_explicit(&r->parks, 1, memory_order_relaxed);
+        futex_wait(seq, s, timeout);  // Returns at once if seq moved since the load
+    }
+}
+
+void wr_init(WatermarkRing *r, uint32_t low_watermark, uint32_t high_watermark) {
+    if (high_watermark == 0 || high_watermark > WR_SIZE) {
+        high_watermark = WR_SIZE;
+    }
+    if (low_watermark >= WR_SIZE) {
+        low_watermark = WR_SIZE - 1;
+    }
+
+    atomic_init(&r->head, 0);
+    atomic_init(&r->tail, 0);
+    atomic_init(&r->data_need, 0);
+    atomic_init(&r->data_seq, 0);
+    atomic_init(&r->space_need, 0);
+    atomic_init(&r->space_seq, 0);
+    r->high_watermark = high_watermark;
+    r->low_watermark = low_watermark;
+    atomic_init(&r->spin_limit, WR_MIN_SPIN);
+    atomic_init(&r->closed, false);
+    atomic_init(&r->parks, 0);
+    atomic_init(&r->spin_hits, 0);
+    atomic_init(&r->wakes, 0);
+}
+
+uint32_t wr_push(WatermarkRing *r, const float *x, uint32_t n) {
+    uint32_t head = atomic_load_explicit(&r->head, memory_order_relaxed);
+    uint32_t tail = atomic_load_explicit(&r->tail, memory_order_acquire);
+    uint32_t space = WR_SIZE - (head - tail);
+
+    if (n > space) {
+        n = space;
+    }
+    for (uint32_t i = 0; i < n; i++) {
+        r->data[(head + i) & WR_MASK] = x[i];
+    }
+    atomic_store(&r->head, head + n);
+
+    notify(r, &r->data_need, &r->data_seq, head + n - tail);
+    return n;
+}
+
+uint32_t wr_pop(WatermarkRing *r, float *x, uint32_t n) {
+    uint32_t tail = atomic_load_explicit(&r->tail, memory_order_relaxed);
+    uint32_t head = atomic_load_explicit(&r->head, memory_order_acquire);
+    uint32_t avail = head - tail;
+
+    if (n > avail) {
+        n = avail;
+    }
+    for (uint32_t i = 0; i < n; i++) {
+        x[i] = r->data[(tail + i) & WR_MASK];
+    }
+    atomic_store(&r->tail, tail + n);
+
+    notify(r, &r->space_need, &r->space_seq, WR_SIZE - (head - tail - n));
+    return n;
+}
+
+uint32_t wr_count(WatermarkRing *r) {
+    return readable(r);
+}
+
+bool wr_wait_readable(WatermarkRing *r, uint32_t n, int timeout_ms) {
+    if (n == 0) {
+        n = r->high_watermark;
+    }
+    if (n > WR_SIZE) {
+        n = WR_SIZE;
+    }
+    return wait_for(r, &r->data_need, &r->data_seq, readable, n, timeout_ms);
+}
+
+bool wr_wait_writable(WatermarkRing *r, uint32_t n, int timeout_ms) {
+    if (n == 0) {
+        n = WR_SIZE - r->low_watermark;
+    }
+    if (n > WR_SIZE) {
+        n = WR_SIZE;
+    }
+    return wait_for(r, &r->space_need, &r->space_seq, writable, n, timeout_ms);
+}
+
+void wr_close(WatermarkRing *r) {
+    atomic_store(&r->closed, true);
+    atomic_fetch_add(&r->data_seq, 1);
+    atomic_fetch_add(&r->space_seq, 1);
+    futex_wake_all(&r->data_seq);
+    futex_wake_all(&r->space_seq);
+}
@@ -0,0 +1,113 @@
+/**
+ * Watermark Ring with Blocking Waits
+ * SPSC sample ring whose consumer sleeps until enough samples are queued
+ *
+ * CircularBuffer is single-threaded, so a consumer on another thread has
+ * to poll cb_count. This ring is shared between one producer and one
+ * consumer thread. The consumer asks for "at least N samples" (by default
+ * the high watermark) and sleeps on a futex until the producer has queued
+ * them, so a 250 Hz stream wakes it once per batch instead of per sample.
+ * A producer that finds the ring full can likewise sleep until the
+ * consumer has drained it to the low watermark.
+ *
+ * Key points:
+ * - Waits spin briefly first; the spin budget adapts to how often spinning
+ *   alone was enough, then the thread parks on a futex (no CPU at idle)
+ * - A producer only makes a syscall when a consumer is actually parked
+ *   and its watermark is reached; otherwise a push is a store and a load
+ * - No lost wake-ups: the waiter publishes what it needs, re-checks, and
+ *   sleeps on a sequence word the waker bumps before FUTEX_WAKE
+ * - wr_close() wakes both sides for shutdown
+ */
+
+#ifndef WATERMARK_RING_H
+#define WATERMARK_RING_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+#define WR_SIZE 1024                // Power of 2
+#define WR_MIN_SPIN 16
+#define WR_MAX_SPIN 4096
+
+typedef struct {
+    float data[WR_SIZE];
+    _Alignas(64) _Atomic uint32_t head;         // Written by producer
+    _Alignas(64) _Atomic uint32_t tail;         // Written by consumer
+
+    // Consumer side parking: samples needed (0 = not parked) + futex word
+    _Alignas(64) _Atomic uint32_t data_need;
+    _Atomic uint32_t data_seq;
+    // Producer side parking: free slots needed + futex word
+    _Alignas(64) _Atomic uint32_t space_need;
+    _Atomic uint32_t space_seq;
+
+    uint32_t high_watermark;        // Default consumer batch
+    uint32_t low_watermark;         // Default producer resume level
+    _Atomic uint32_t spin_limit;    // Adaptive spin budget
+    _Atomic bool closed;
+
+    _Atomic uint64_t parks;         // Waits that slept in the kernel
+    _Atomic uint64_t spin_hits;     // Waits satisfied while spinning
+    _Atomic uint64_t wakes;         // FUTEX_WAKE calls issued
+} WatermarkRing;
+
+/**
+ * Initialize an empty ring
+ * @param r Pointer to WatermarkRing
+ * @param low_watermark Producer resumes once the ring drains to this depth
+ * @param high_watermark Consumer wakes once the ring reaches this depth
+ */
+void wr_init(WatermarkRing *r, uint32_t low_watermark, uint32_t high_watermark);
+
+/**
+ * Append samples (producer thread, never blocks)
+ * @param r Pointer to WatermarkRing
+ * @param x Samples
+ * @param n Number of samples
+ * @return Number written (less than n if the ring filled up)
+ */
+uint32_t wr_push(WatermarkRing *r, const float *x, uint32_t n);
+
+/**
+ * Remove samples (consumer thread, never blocks)
+ * @param r Pointer to WatermarkRing
+ * @param x Output array
+ * @param n Capacity of x
+ * @return Number read
+ */
+uint32_t wr_pop(WatermarkRing *r, float *x, uint32_t n);
+
+/**
+ * Get number of queued samples
+ * @param r Pointer to WatermarkRing
+ * @return Queued samples
+ */
+uint32_t wr_count(WatermarkRing *r);
+
+/**
+ * Wait until at least n samples are queued (consumer thread)
+ * @param r Pointer to WatermarkRing
+ * @param n Samples wanted, 0 = high watermark
+ * @param timeout_ms Give up after this long, negative = forever
+ * @return true if n samples are available, false on timeout or close
+ */
+bool wr_wait_readable(WatermarkRing *r, uint32_t n, int timeout_ms);
+
+/**
+ * Wait until at least n slots are free (producer thread)
+ * @param r Pointer to WatermarkRing
+ * @param n Free slots wanted, 0 = drained to the low watermark
+ * @param timeout_ms Give up after this long, negative = forever
+ * @return true if the space is available, false on timeout or close
+ */
+bool wr_wait_writable(WatermarkRing *r, uint32_t n, int timeout_ms);
+
+/**
+ * Mark the ring closed and wake any waiter
+ * @param r Pointer to WatermarkRing
+ */
+void wr_close(WatermarkRing *r);
+
+#endif // WATERMARK_RING_H